@@ -54,6 +54,20 @@ void PLATFORM_ATTR_ISR C64Emu::intervalTimerProfilingBatteryCheckFunc() {
                       std::memory_order_release);
   }
   cpu.vic.cntRefreshs.store(0, std::memory_order_release);
+  // frames not shown / shown more than once
+  cntFramesDropped.store(
+      cpu.vic.cntFramesDropped.exchange(0, std::memory_order_acq_rel),
+      std::memory_order_release);
+  cntFramesDuplicated.store(
+      cpu.vic.cntFramesDuplicated.exchange(0, std::memory_order_acq_rel),
+      std::memory_order_release);
+  sumFrameLatencyUS.store(
+      cpu.vic.sumFrameLatencyUS.exchange(0, std::memory_order_acq_rel),
+      std::memory_order_release);
+  // lines sent to the display (partial display updates)
+  cntLinesSent.store(
+      cpu.vic.cntLinesSent.exchange(0, std::memory_order_acq_rel),
+      std::memory_order_release);
   // number of cycles per second
   numofcyclespersecond.store(
       cpu.numofcyclespersecond.load(std::memory_order_acquire),
@@ -61,8 +75,16 @@ void PLATFORM_ATTR_ISR C64Emu::intervalTimerProfilingBatteryCheckFunc() {
   numofburnedcyclespersecond.store(
       cpu.numofburnedcyclespersecond.load(std::memory_order_acquire),
       std::memory_order_release);
+  numofidlecyclespersecond.store(
+      cpu.numofidlecyclespersecond.load(std::memory_order_acquire),
+      std::memory_order_release);
+  numofcopyfillcyclespersecond.store(
+      cpu.numofcopyfillcyclespersecond.load(std::memory_order_acquire),
+      std::memory_order_release);
   cpu.numofcyclespersecond.store(0, std::memory_order_release);
   cpu.numofburnedcyclespersecond.store(0, std::memory_order_release);
+  cpu.numofidlecyclespersecond.store(0, std::memory_order_release);
+  cpu.numofcopyfillcyclespersecond.store(0, std::memory_order_release);
   showperfvalues.store(true, std::memory_order_release);
 }
 
@@ -88,7 +110,7 @@ void C64Emu::cpuCode(void *parameter) {
   // cpu runs forever -> no vTaskDelete(NULL);
 }
 
-void C64Emu::setup() {
+void C64Emu::initSystem() {
   // init platform
   PlatformManager::initialize(PlatformNS::create());
   PlatformManager::getInstance().log(LOG_INFO, TAG, "start setup...");
@@ -137,6 +159,10 @@ void C64Emu::setup() {
   WiFiManager::getInstance()->setRamPointer(ram);
 #endif
 #endif
+}
+
+void C64Emu::setup() {
+  initSystem();
 
   // start cpu task
   using namespace std::placeholders;
@@ -161,7 +187,8 @@ void C64Emu::loop() {
   PlatformManager::getInstance().unlock();
   cpu.keyboard->syncAndCreateAttachWinSDL();
   PlatformManager::getInstance().feedWDT();
-  PlatformManager::getInstance().waitMS(Config::REFRESHDELAY);
+  // wait for the next frame completed by the VIC
+  PlatformManager::getInstance().waitForFrame(REFRESHTIMEOUT);
   if (cpu.perf.load(std::memory_order_acquire) &&
       showperfvalues.load(std::memory_order_acquire)) {
     showperfvalues.store(false, std::memory_order_release);
@@ -171,12 +198,37 @@ void C64Emu::loop() {
           LOG_INFO, TAG, "fps: %d",
           cntRefreshs.load(std::memory_order_acquire));
     }
+    // average time from completing a frame to having sent it to the display
+    int32_t cntNewFrames = cntRefreshs.load(std::memory_order_acquire) -
+                           cntFramesDuplicated.load(std::memory_order_acquire);
+    if (cntNewFrames > 0) {
+      PlatformManager::getInstance().log(
+          LOG_INFO, TAG, "frame latency: %lu us",
+          sumFrameLatencyUS.load(std::memory_order_acquire) / cntNewFrames);
+    }
     cntRefreshs.store(0, std::memory_order_release);
+    // frame pacing
+    PlatformManager::getInstance().log(
+        LOG_INFO, TAG, "frames dropped: %d, duplicated: %d",
+        cntFramesDropped.load(std::memory_order_acquire),
+        cntFramesDuplicated.load(std::memory_order_acquire));
+    // number of lines sent to the display per second
+    if (cpu.vic.display->supportsBitmapLines()) {
+      PlatformManager::getInstance().log(
+          LOG_INFO, TAG, "lines sent: %lu",
+          cntLinesSent.load(std::memory_order_acquire));
+    }
+    // number of frames skipped after each drawn frame
+    PlatformManager::getInstance().log(
+        LOG_INFO, TAG, "frame skip: %d",
+        cpu.frameskiplevel.load(std::memory_order_acquire));
     // number of cycles per second
     PlatformManager::getInstance().log(
-        LOG_INFO, TAG, "noc: %lu, nbc: %lu",
+        LOG_INFO, TAG, "noc: %lu, nbc: %lu, nic: %lu, ncc: %lu",
         numofcyclespersecond.load(std::memory_order_acquire),
-        numofburnedcyclespersecond.load(std::memory_order_acquire));
+        numofburnedcyclespersecond.load(std::memory_order_acquire),
+        numofidlecyclespersecond.load(std::memory_order_acquire),
+        numofcopyfillcyclespersecond.load(std::memory_order_acquire));
     PlatformManager::getInstance().log(
         LOG_INFO, TAG, "voltage: %d",
         cpu.batteryVoltage.load(std::memory_order_acquire));
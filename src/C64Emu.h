@@ -24,6 +24,10 @@
 
 class C64Emu {
 private:
+  // maximal time to wait for a new frame before refreshing the display anyway
+  // (e.g. cpu halted)
+  static const uint8_t REFRESHTIMEOUT = 100;
+
   uint8_t *ram;
   BoardDriver *board;
   uint16_t cntSecondsForBatteryCheck;
@@ -38,9 +42,16 @@ public:
   C64Sys cpu;
   std::atomic<bool> showperfvalues = false;
   std::atomic<uint8_t> cntRefreshs = 0;
+  std::atomic<uint16_t> cntFramesDropped = 0;
+  std::atomic<uint16_t> cntFramesDuplicated = 0;
+  std::atomic<uint32_t> sumFrameLatencyUS = 0;
+  std::atomic<uint32_t> cntLinesSent = 0;
   std::atomic<uint32_t> numofcyclespersecond = 0;
   std::atomic<uint32_t> numofburnedcyclespersecond = 0;
+  std::atomic<uint32_t> numofidlecyclespersecond = 0;
+  std::atomic<uint32_t> numofcopyfillcyclespersecond = 0;
 
+  void initSystem();
   void setup();
   void loop();
 };
@@ -17,7 +17,7 @@
 #include "C64Sys.h"
 
 #include "CIA.h"
-#include "CPU6502.h"
+#include "CPU6502Impl.h"
 #include "Config.h"
 #include "ExtCmdQueue.h"
 #include "ExternalCmds.h"
@@ -106,109 +106,123 @@ uint8_t C64Sys::getDC01(uint8_t dc00, bool xchgports) {
 }
 
 uint8_t C64Sys::getMem(uint16_t addr) {
-  if ((!bankARAM) && ((addr >= 0xa000) && (addr <= 0xbfff))) {
-    //    basic rom
-    return basic_rom[addr - 0xa000];
-  } else if ((!bankERAM) && (addr >= 0xe000)) {
-    // kernal rom
-    return kernal_rom[addr - 0xe000];
-  } else if (bankDIO && (addr >= 0xd000) && (addr <= 0xdfff)) {
-    // ** VIC **
-    if (addr <= 0xd3ff) {
-      uint8_t vicidx = (addr - 0xd000) % 0x40;
-      if ((vicidx == 0x1e) || (vicidx == 0x1f)) {
-        uint8_t val = vic.vicreg[vicidx];
-        vic.vicreg[vicidx] = 0;
-        return val;
-      } else if (vicidx == 0x11) {
-        uint8_t raster8 = (vic.rasterline >= 256) ? 0x80 : 0;
-        return (vic.vicreg[0x11] & 0x7f) | raster8;
-      } else {
-        return vic.vicreg[vicidx];
-      }
+  const uint8_t *page = readPages[addr >> 8];
+  if (page != nullptr) {
+    // ram or rom
+    return page[addr & 0xff];
+  }
+  return getIOMem(addr);
+}
+
+uint8_t C64Sys::getIOMem(uint16_t addr) {
+  // i/o area d000-dfff (when banked in)
+  // ** VIC **
+  if (addr <= 0xd3ff) {
+    uint8_t vicidx = (addr - 0xd000) % 0x40;
+    if ((vicidx == 0x1e) || (vicidx == 0x1f)) {
+      uint8_t val = vic.vicreg[vicidx];
+      vic.vicreg[vicidx] = 0;
+      return val;
+    } else if (vicidx == 0x11) {
+      uint8_t raster8 = (vic.rasterline >= 256) ? 0x80 : 0;
+      return (vic.vicreg[0x11] & 0x7f) | raster8;
+    } else {
+      return vic.vicreg[vicidx];
     }
-    // ** SID **
-    else if (addr <= 0xd7ff) {
-      uint8_t sididx = (addr - 0xd400) % 0x20;
-      if (sididx == 0x1b) {
-        return PlatformManager::getInstance().getRandomByte();
-      } else if (sididx == 0x1c) {
-        return static_cast<uint8_t>(sid.sidVoice[2].envelope) * 255.0f;
-      } else {
-        return sid.sidreg[sididx];
+  }
+  // ** SID **
+  else if (addr <= 0xd7ff) {
+    uint8_t sididx = (addr - 0xd400) % 0x20;
+    if (sididx == 0x1b) {
+      return PlatformManager::getInstance().getRandomByte();
+    } else if (sididx == 0x1c) {
+      return static_cast<uint8_t>(sid.sidVoice[2].envelope) * 255.0f;
+    } else {
+      return sid.sidreg[sididx];
+    }
+  }
+  // ** Colorram **
+  else if (addr <= 0xdbff) {
+    return vic.colormap[addr - 0xd800];
+  }
+  // ** CIA 1 **
+  else if (addr <= 0xdcff) {
+    uint8_t ciaidx = (addr - 0xdc00) % 0x10;
+    if (ciaidx >= 0x04) {
+      syncCIAs();
+      if (ciaidx == 0x0d) {
+        // next timer underflow may request an interrupt again
+        nextevent = 0;
       }
     }
-    // ** Colorram **
-    else if (addr <= 0xdbff) {
-      return vic.colormap[addr - 0xd800];
-    }
-    // ** CIA 1 **
-    else if (addr <= 0xdcff) {
-      uint8_t ciaidx = (addr - 0xdc00) % 0x10;
-      if (ciaidx == 0x00) {
-        uint8_t ddra = cia1.ciareg[0x02];
-        uint8_t input = getDC01(cia1.ciareg[0x01], true);
-        if ((joystickmode == 2) && (!specialjoymode)) {
-          if (input == 0xff) {
-            // no key pressed -> return joystick value (of real joystick)
-            input = joystick->getValue();
-          }
-        } else if (kbjoystickmode == 2) {
-          if (input == 0xff) {
-            // no key pressed -> return joystick value (of keyboard joystick)
-            input = keyboard->getKBJoyValue();
-          }
+    if (ciaidx == 0x00) {
+      uint8_t ddra = cia1.ciareg[0x02];
+      uint8_t input = getDC01(cia1.ciareg[0x01], true);
+      if ((joystickmode == 2) && (!specialjoymode)) {
+        if (input == 0xff) {
+          // no key pressed -> return joystick value (of real joystick)
+          input = joystick->getValue();
         }
-        return (cia1.ciareg[0x00] | ~ddra) & input;
-      } else if (ciaidx == 0x01) {
-        uint8_t ddrb = cia1.ciareg[0x03];
-        uint8_t input = getDC01(cia1.ciareg[0x00], false);
-        if ((joystickmode == 2) && (!specialjoymode)) {
-          // special case: handle fire2 button -> space key
-          if ((cia1.ciareg[0x00] == 0x7f) && joystick->getFire2()) {
-            return 0xef;
-          }
+      } else if (kbjoystickmode == 2) {
+        if (input == 0xff) {
+          // no key pressed -> return joystick value (of keyboard joystick)
+          input = keyboard->getKBJoyValue();
         }
-        if ((joystickmode == 1) && (!specialjoymode)) {
-          if (input == 0xff) {
-            // no key pressed -> return joystick value (of real joystick)
-            input = joystick->getValue();
-          }
-        } else if (kbjoystickmode == 1) {
-          if (input == 0xff) {
-            // no key pressed -> return joystick value (of keyboard joystick)
-            input = keyboard->getKBJoyValue();
-          }
+      }
+      return (cia1.ciareg[0x00] | ~ddra) & input;
+    } else if (ciaidx == 0x01) {
+      uint8_t ddrb = cia1.ciareg[0x03];
+      uint8_t input = getDC01(cia1.ciareg[0x00], false);
+      if ((joystickmode == 2) && (!specialjoymode)) {
+        // special case: handle fire2 button -> space key
+        if ((cia1.ciareg[0x00] == 0x7f) && joystick->getFire2()) {
+          return 0xef;
         }
-        return (cia1.ciareg[0x01] | ~ddrb) & input;
       }
-      return cia1.getCommonCIAReg(ciaidx);
-    }
-    // ** CIA 2 **
-    else if (addr <= 0xddff) {
-      uint8_t ciaidx = (addr - 0xdd00) % 0x10;
-      if (ciaidx == 0x00) {
-        uint8_t ddra = cia2.ciareg[0x02];
-        return cia2.ciareg[0x00] | ~ddra;
-      } else if (ciaidx == 0x01) {
-        uint8_t ddrb = cia2.ciareg[0x03];
-        return cia2.ciareg[0x01] | ~ddrb;
-      } else if (ciaidx == 0x0d) {
-        nmiAck = true;
+      if ((joystickmode == 1) && (!specialjoymode)) {
+        if (input == 0xff) {
+          // no key pressed -> return joystick value (of real joystick)
+          input = joystick->getValue();
+        }
+      } else if (kbjoystickmode == 1) {
+        if (input == 0xff) {
+          // no key pressed -> return joystick value (of keyboard joystick)
+          input = keyboard->getKBJoyValue();
+        }
       }
-      return cia2.getCommonCIAReg(ciaidx);
+      return (cia1.ciareg[0x01] | ~ddrb) & input;
     }
-  } else if ((!bankDRAM) && (addr >= 0xd000) && (addr <= 0xdfff)) {
-    // dxxx character rom
-    return charrom[addr - 0xd000];
-  } else if (addr == 0x0001) {
-    return register1;
+    return cia1.getCommonCIAReg(ciaidx);
   }
-  // ram
+  // ** CIA 2 **
+  else if (addr <= 0xddff) {
+    uint8_t ciaidx = (addr - 0xdd00) % 0x10;
+    if (ciaidx >= 0x04) {
+      syncCIAs();
+      if (ciaidx == 0x0d) {
+        nextevent = 0;
+      }
+    }
+    if (ciaidx == 0x00) {
+      uint8_t ddra = cia2.ciareg[0x02];
+      return cia2.ciareg[0x00] | ~ddra;
+    } else if (ciaidx == 0x01) {
+      uint8_t ddrb = cia2.ciareg[0x03];
+      return cia2.ciareg[0x01] | ~ddrb;
+    } else if (ciaidx == 0x0d) {
+      nmiAck = true;
+    }
+    return cia2.getCommonCIAReg(ciaidx);
+  }
+  // i/o area de00-dfff is not emulated
   return ram[addr];
 }
 
 void C64Sys::decodeRegister1(uint8_t val) {
+  bool bankARAM;
+  bool bankDRAM;
+  bool bankERAM;
+  bool bankDIO;
   switch (val) {
   case 0:
   case 4:
@@ -254,6 +268,25 @@ void C64Sys::decodeRegister1(uint8_t val) {
     bankDIO = true;
     break;
   }
+  // rebuild the page tables of the banked areas
+  for (uint16_t page = 0xa0; page <= 0xbf; page++) {
+    readPages[page] = bankARAM ? ram + (page << 8)
+                               : basic_rom + ((page - 0xa0) << 8);
+  }
+  for (uint16_t page = 0xd0; page <= 0xdf; page++) {
+    if (bankDIO) {
+      readPages[page] = nullptr;
+      writePages[page] = nullptr;
+    } else {
+      readPages[page] = bankDRAM ? ram + (page << 8)
+                                 : charrom + ((page - 0xd0) << 8);
+      writePages[page] = ram + (page << 8);
+    }
+  }
+  for (uint16_t page = 0xe0; page <= 0xff; page++) {
+    readPages[page] = bankERAM ? ram + (page << 8)
+                               : kernal_rom + ((page - 0xe0) << 8);
+  }
 }
 
 void C64Sys::adaptVICBaseAddrs(bool fromcia) {
@@ -286,125 +319,149 @@ void C64Sys::adaptVICBaseAddrs(bool fromcia) {
 }
 
 void C64Sys::setMem(uint16_t addr, uint8_t val) {
-  if (bankDIO && (addr >= 0xd000) && (addr <= 0xdfff)) {
-    // ** VIC **
-    if (addr <= 0xd3ff) {
-      uint8_t vicidx = (addr - 0xd000) % 0x40;
-      if (vicidx == 0x11) {
-        // only bit 7 of latch register d011 is used
-        vic.latchd011 = val;
-        vic.vicreg[vicidx] = val & 0x7f;
-        adaptVICBaseAddrs(false);
-      } else if (vicidx == 0x12) {
-        vic.latchd012 = val;
-      } else if (vicidx == 0x16) {
-        vic.vicreg[vicidx] = val;
-        adaptVICBaseAddrs(false);
-      } else if (vicidx == 0x18) {
-        vic.vicreg[vicidx] = val;
-        adaptVICBaseAddrs(false);
-      } else if (vicidx == 0x19) {
-        // clear given bits
-        /*
-        // does not work for all games, e.g. bubble bobble
-        uint8_t act = vic.vicreg[vicidx];
-        act &= ~val;
-        if ((act & 7) == 0) {
-          act &= ~0x80;
-        }
-        vic.vicreg[vicidx] = val;
-        */
-        vic.vicreg[vicidx] = 0;
-      } else if ((vicidx == 0x1e) || (vicidx == 0x1f)) {
-        vic.vicreg[vicidx] = 0;
-      } else {
-        vic.vicreg[vicidx] = val;
-      }
-    }
-    // ** SID **
-    else if (addr <= 0xd7ff) {
-      uint8_t sididx = (addr - 0xd400) % 0x20;
-      sid.sidreg[sididx] = val;
-      if (sididx <= 0x14) {
-        uint8_t voice = sididx / 7;
-        int regInVoice = sididx % 7;
-        switch (regInVoice) {
-        case 0:
-        case 1:
-          sid.sidVoice[voice].updVarFrequency(sid.sidreg[voice * 7] |
-                                              (sid.sidreg[1 + voice * 7] << 8));
-          break;
-        case 2:
-        case 3:
-          sid.sidVoice[voice].updVarPulseWidth(
-              sid.sidreg[2 + voice * 7] | (sid.sidreg[3 + voice * 7] << 8));
-          break;
-        case 4:
-          sid.sidVoice[voice].updVarControl(sid.sidreg[sididx]);
-          break;
-        case 5:
-          sid.sidVoice[voice].updVarEnvelopeAD(sid.sidreg[sididx]);
-          break;
-        case 6:
-          sid.sidVoice[voice].updVarEnvelopeSR(sid.sidreg[sididx]);
-          break;
-        }
-      } else if (sididx == 0x18) {
-        sid.c64Volume = (float)(val & 0x0f) / 15.0;
+  uint8_t *page = writePages[addr >> 8];
+  if ((page != nullptr) && (addr > 0x0001)) {
+    // ram (also "below" rom), registers 0 and 1 are handled by setIOMem()
+    page[addr & 0xff] = val;
+    return;
+  }
+  setIOMem(addr, val);
+}
+
+void C64Sys::setIOMem(uint16_t addr, uint8_t val) {
+  // ** zero page ** (registers 0 and 1)
+  if (addr <= 0x00ff) {
+    // ram "below" register 1 is also written, so register 1 can be read via
+    // the page table
+    ram[addr] = val;
+    // ** register 1 **
+    if (addr == 0x0001) {
+      bool bankswitch = (val & 7) != (register1 & 7);
+      register1 = val;
+      if (bankswitch) {
+        decodeRegister1(register1 & 7);
       }
     }
-    // ** Colorram **
-    else if (addr <= 0xdbff) {
-      vic.colormap[addr - 0xd800] = val;
-    }
-    // ** CIA 1 **
-    else if (addr <= 0xdcff) {
-      uint8_t ciaidx = (addr - 0xdc00) % 0x10;
-      if (ciaidx == 0x00) {
-        uint8_t ddra = cia1.ciareg[0x02];
-        cia1.ciareg[ciaidx] = (cia1.ciareg[ciaidx] & ~ddra) | (val & ddra);
-      } else if (ciaidx == 0x01) {
-        uint8_t ddrb = cia1.ciareg[0x03];
-        cia1.ciareg[ciaidx] = (cia1.ciareg[ciaidx] & ~ddrb) | (val & ddrb);
-      } else {
-        cia1.setCommonCIAReg(ciaidx, val);
+    return;
+  }
+  // i/o area d000-dfff (when banked in)
+  // ** VIC **
+  if (addr <= 0xd3ff) {
+    uint8_t vicidx = (addr - 0xd000) % 0x40;
+    if (vicidx == 0x11) {
+      // only bit 7 of latch register d011 is used
+      vic.latchd011 = val;
+      vic.vicreg[vicidx] = val & 0x7f;
+      adaptVICBaseAddrs(false);
+    } else if (vicidx == 0x12) {
+      vic.latchd012 = val;
+    } else if (vicidx == 0x16) {
+      vic.vicreg[vicidx] = val;
+      adaptVICBaseAddrs(false);
+    } else if (vicidx == 0x18) {
+      vic.vicreg[vicidx] = val;
+      adaptVICBaseAddrs(false);
+    } else if (vicidx == 0x19) {
+      // clear given bits
+      /*
+      // does not work for all games, e.g. bubble bobble
+      uint8_t act = vic.vicreg[vicidx];
+      act &= ~val;
+      if ((act & 7) == 0) {
+        act &= ~0x80;
       }
+      vic.vicreg[vicidx] = val;
+      */
+      vic.vicreg[vicidx] = 0;
+    } else if (vicidx == 0x1a) {
+      vic.vicreg[vicidx] = val;
+      // check for a pending interrupt request
+      nextevent = 0;
+    } else if ((vicidx == 0x1e) || (vicidx == 0x1f)) {
+      vic.vicreg[vicidx] = 0;
+    } else {
+      vic.vicreg[vicidx] = val;
     }
-    // ** CIA 2 **
-    else if (addr <= 0xddff) {
-      uint8_t ciaidx = (addr - 0xdd00) % 0x10;
-      if (ciaidx == 0x00) {
-        uint8_t bank = val & 3;
-        switch (bank) {
-        case 0:
-          vic.vicmem = 0xc000;
-          break;
-        case 1:
-          vic.vicmem = 0x8000;
-          break;
-        case 2:
-          vic.vicmem = 0x4000;
-          break;
-        case 3:
-          vic.vicmem = 0x0000;
-          break;
-        }
-        cia2.ciareg[ciaidx] = 0x94 | bank;
-        // adapt VIC base addresses
-        adaptVICBaseAddrs(true);
-      } else {
-        cia2.setCommonCIAReg(ciaidx, val);
+  }
+  // ** SID **
+  else if (addr <= 0xd7ff) {
+    uint8_t sididx = (addr - 0xd400) % 0x20;
+    sid.sidreg[sididx] = val;
+    if (sididx <= 0x14) {
+      uint8_t voice = sididx / 7;
+      int regInVoice = sididx % 7;
+      switch (regInVoice) {
+      case 0:
+      case 1:
+        sid.sidVoice[voice].updVarFrequency(sid.sidreg[voice * 7] |
+                                            (sid.sidreg[1 + voice * 7] << 8));
+        break;
+      case 2:
+      case 3:
+        sid.sidVoice[voice].updVarPulseWidth(
+            sid.sidreg[2 + voice * 7] | (sid.sidreg[3 + voice * 7] << 8));
+        break;
+      case 4:
+        sid.sidVoice[voice].updVarControl(sid.sidreg[sididx]);
+        break;
+      case 5:
+        sid.sidVoice[voice].updVarEnvelopeAD(sid.sidreg[sididx]);
+        break;
+      case 6:
+        sid.sidVoice[voice].updVarEnvelopeSR(sid.sidreg[sididx]);
+        break;
       }
+    } else if (sididx == 0x18) {
+      sid.c64Volume = (float)(val & 0x0f) / 15.0;
     }
   }
-  // ** register 1 **
-  else if (addr == 0x0001) {
-    register1 = val;
-    decodeRegister1(register1 & 7);
+  // ** Colorram **
+  else if (addr <= 0xdbff) {
+    vic.colormap[addr - 0xd800] = val;
   }
-  // ** ram **
-  else {
-    ram[addr] = val;
+  // ** CIA 1 **
+  else if (addr <= 0xdcff) {
+    uint8_t ciaidx = (addr - 0xdc00) % 0x10;
+    if (ciaidx == 0x00) {
+      uint8_t ddra = cia1.ciareg[0x02];
+      cia1.ciareg[ciaidx] = (cia1.ciareg[ciaidx] & ~ddra) | (val & ddra);
+    } else if (ciaidx == 0x01) {
+      uint8_t ddrb = cia1.ciareg[0x03];
+      cia1.ciareg[ciaidx] = (cia1.ciareg[ciaidx] & ~ddrb) | (val & ddrb);
+    } else {
+      // timers are synchronized before and rescheduled after the write
+      syncCIAs();
+      cia1.setCommonCIAReg(ciaidx, val);
+      nextevent = 0;
+    }
+  }
+  // ** CIA 2 **
+  else if (addr <= 0xddff) {
+    uint8_t ciaidx = (addr - 0xdd00) % 0x10;
+    if (ciaidx == 0x00) {
+      uint8_t bank = val & 3;
+      switch (bank) {
+      case 0:
+        vic.vicmem = 0xc000;
+        break;
+      case 1:
+        vic.vicmem = 0x8000;
+        break;
+      case 2:
+        vic.vicmem = 0x4000;
+        break;
+      case 3:
+        vic.vicmem = 0x0000;
+        break;
+      }
+      cia2.ciareg[ciaidx] = 0x94 | bank;
+      // adapt VIC base addresses
+      adaptVICBaseAddrs(true);
+    } else {
+      syncCIAs();
+      cia2.setCommonCIAReg(ciaidx, val);
+      nextevent = 0;
+    }
   }
 }
 
@@ -445,55 +502,447 @@ uint8_t C64Sys::getSR() { return sr; }
 uint16_t C64Sys::getPC() { return pc; }
 void C64Sys::setPC(uint16_t newPC) { pc = newPC; }
 
-void C64Sys::checkciatimers(uint8_t cycles) {
-  // CIA 1 TOD alarm
-  cia1.checkAlarm();
-  // check for CIA 1 TOD alarm interrupt
-  if (((cia1.latchdc0d & 0x84) == 0x84) && (!iflag)) {
-    setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
+void C64Sys::syncCIAs() {
+  uint8_t cycles = numofcycles - ciasynccycles;
+  if (cycles != 0) {
+    cia1.advanceTimers(cycles);
+    cia2.advanceTimers(cycles);
+    ciasynccycles = numofcycles;
   }
-  // CIA 1 Timer A
-  cia1.checkTimerA(cycles);
-  // check for CIA 1 Timer A interrupt
-  if (((cia1.latchdc0d & 0x81) == 0x81) && (!iflag)) {
-    setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
-  }
-  // CIA 1 Timer B
-  cia1.checkTimerB(cycles);
-  // check for CIA 1 Timer B interrupt
-  if (((cia1.latchdc0d & 0x82) == 0x82) && (!iflag)) {
-    setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
-  }
-  // check for CIA 1 SDR interrupt
-  if (((cia1.latchdc0d & 0x88) == 0x88) && (!iflag)) {
+}
+
+void C64Sys::checkInterrupts() {
+  // IRQ: VIC raster interrupt or CIA 1 interrupt
+  if ((!iflag) &&
+      (((vic.vicreg[0x19] & 0x81) && (vic.vicreg[0x1a] & 1)) ||
+       ((cia1.latchdc0d & 0x80) && (cia1.latchdc0d & 0x0f)))) {
+    loopvalid = false;
     setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
   }
-  // CIA 2 TOD alarm
-  cia2.checkAlarm();
-  // check for CIA 2 TOD alarm interrupt
-  if (((cia2.latchdc0d & 0x84) == 0x84) && nmiAck) {
+  // NMI: CIA 2 interrupt
+  if ((cia2.latchdc0d & 0x80) && (cia2.latchdc0d & 0x0f) && nmiAck) {
     nmiAck = false;
+    loopvalid = false;
     setPCToIntVec(getMem(0xfffa) + (getMem(0xfffb) << 8), false);
   }
-  // CIA 2 Timer A
-  cia2.checkTimerA(cycles);
-  // check for CIA 2 Timer A interrupt
-  if (((cia2.latchdc0d & 0x81) == 0x81) && nmiAck) {
-    nmiAck = false;
-    setPCToIntVec(getMem(0xfffa) + (getMem(0xfffb) << 8), false);
+}
+
+void C64Sys::handleEvents() {
+  syncCIAs();
+  // draw rasterline in the middle of the cpu cycles of the rasterline
+  if ((!linedrawn) && (numofcycles >= drawcycle)) {
+    vic.drawRasterline();
+    linedrawn = true;
+    // VIC registers may have changed (collisions)
+    if (loopreadsio) {
+      loopvalid = false;
+    }
   }
-  // CIA 2 Timer B
-  cia2.checkTimerB(cycles);
-  // check for CIA 2 Timer B interrupt
-  if (((cia2.latchdc0d & 0x82) == 0x82) && nmiAck) {
-    nmiAck = false;
-    setPCToIntVec(getMem(0xfffa) + (getMem(0xfffb) << 8), false);
+  checkInterrupts();
+  scheduleNextEvent();
+}
+
+void C64Sys::scheduleNextEvent() {
+  // the end of the rasterline is checked by run(), a CIA returns 0xffff if
+  // none of its interrupts can be requested (must not wrap around)
+  uint8_t next = linedrawn ? 0xff : drawcycle;
+  uint16_t cycles1 = cia1.cyclesToInterrupt();
+  uint16_t cycles2 = cia2.cyclesToInterrupt();
+  uint16_t cycles = (cycles1 < cycles2) ? cycles1 : cycles2;
+  if (cycles < next - numofcycles) {
+    next = numofcycles + cycles;
   }
-  // check for CIA 2 SDR interrupt
-  if (((cia2.latchdc0d & 0x88) == 0x88) && nmiAck) {
-    nmiAck = false;
-    setPCToIntVec(getMem(0xfffa) + (getMem(0xfffb) << 8), false);
+  nextevent = next;
+}
+
+#ifdef LINUX_BENCH
+bool C64Sys::checkEventScheduling() {
+  uint8_t mask1 = cia1.ciareg[0x0d];
+  uint8_t mask2 = cia2.ciareg[0x0d];
+  uint8_t actcycles = numofcycles;
+  bool actlinedrawn = linedrawn;
+  cia1.ciareg[0x0d] = 0;
+  cia2.ciareg[0x0d] = 0;
+  bool ok = true;
+  for (numofcycles = 0; numofcycles < 63; numofcycles++) {
+    linedrawn = numofcycles >= drawcycle;
+    scheduleNextEvent();
+    if (nextevent <= numofcycles) {
+      ok = false;
+    }
+  }
+  cia1.ciareg[0x0d] = mask1;
+  cia2.ciareg[0x0d] = mask2;
+  numofcycles = actcycles;
+  linedrawn = actlinedrawn;
+  scheduleNextEvent();
+  return ok;
+}
+#endif
+
+// registers and flags used by isIdleLoop()
+static const uint8_t LOCA = 0x01;
+static const uint8_t LOCX = 0x02;
+static const uint8_t LOCY = 0x04;
+static const uint8_t LOCN = 0x08;
+static const uint8_t LOCZ = 0x10;
+static const uint8_t LOCC = 0x20;
+static const uint8_t LOCV = 0x40;
+
+bool C64Sys::isIdleLoop(uint16_t startaddr, uint16_t branchaddr) {
+  // The loop body must be a sequence of loads, stores, compares and transfers
+  // (no indexed addressing). If no register, flag or memory location is read
+  // before it is written in the loop body, all values written by the loop
+  // only depend on values not written by the loop. So each repetition of the
+  // loop writes the same values and takes the same branch.
+  static const uint8_t MAXLOOPLEN = 32;
+  static const uint8_t MAXMEMLOCS = 4;
+  loopreadsio = false;
+  if ((branchaddr < startaddr) || (branchaddr - startaddr > MAXLOOPLEN)) {
+    return false;
+  }
+  uint8_t written = 0;
+  uint8_t readfirst = 0;
+  uint16_t memwritten[MAXMEMLOCS];
+  uint8_t nummemwritten = 0;
+  uint16_t memreadfirst[MAXMEMLOCS];
+  uint8_t nummemreadfirst = 0;
+  uint16_t addr = startaddr;
+  while (addr != branchaddr) {
+    if (addr > branchaddr) {
+      return false;
+    }
+    const uint8_t *page = readPages[addr >> 8];
+    if ((page == nullptr) || ((addr & 0xff) > 0xfd)) {
+      return false;
+    }
+    const uint8_t *instr = page + (addr & 0xff);
+    uint8_t opcode = instr[0];
+    uint8_t len = 1;
+    uint8_t reads = 0;
+    uint8_t writes = 0;
+    bool memread = false;
+    bool memwrite = false;
+    switch (opcode) {
+    case 0xa9: // lda
+    case 0xa5:
+    case 0xad:
+      writes = LOCA | LOCN | LOCZ;
+      memread = true;
+      break;
+    case 0xa2: // ldx
+    case 0xa6:
+    case 0xae:
+      writes = LOCX | LOCN | LOCZ;
+      memread = true;
+      break;
+    case 0xa0: // ldy
+    case 0xa4:
+    case 0xac:
+      writes = LOCY | LOCN | LOCZ;
+      memread = true;
+      break;
+    case 0x85: // sta
+    case 0x8d:
+      reads = LOCA;
+      memwrite = true;
+      break;
+    case 0x86: // stx
+    case 0x8e:
+      reads = LOCX;
+      memwrite = true;
+      break;
+    case 0x84: // sty
+    case 0x8c:
+      reads = LOCY;
+      memwrite = true;
+      break;
+    case 0xc9: // cmp
+    case 0xc5:
+    case 0xcd:
+      reads = LOCA;
+      writes = LOCN | LOCZ | LOCC;
+      memread = true;
+      break;
+    case 0xe0: // cpx
+    case 0xe4:
+    case 0xec:
+      reads = LOCX;
+      writes = LOCN | LOCZ | LOCC;
+      memread = true;
+      break;
+    case 0xc0: // cpy
+    case 0xc4:
+    case 0xcc:
+      reads = LOCY;
+      writes = LOCN | LOCZ | LOCC;
+      memread = true;
+      break;
+    case 0x24: // bit
+    case 0x2c:
+      reads = LOCA;
+      writes = LOCN | LOCV | LOCZ;
+      memread = true;
+      break;
+    case 0x29: // and
+    case 0x25:
+    case 0x2d:
+    case 0x09: // ora
+    case 0x05:
+    case 0x0d:
+      reads = LOCA;
+      writes = LOCA | LOCN | LOCZ;
+      memread = true;
+      break;
+    case 0xaa: // tax
+      reads = LOCA;
+      writes = LOCX | LOCN | LOCZ;
+      break;
+    case 0xa8: // tay
+      reads = LOCA;
+      writes = LOCY | LOCN | LOCZ;
+      break;
+    case 0x8a: // txa
+      reads = LOCX;
+      writes = LOCA | LOCN | LOCZ;
+      break;
+    case 0x98: // tya
+      reads = LOCY;
+      writes = LOCA | LOCN | LOCZ;
+      break;
+    case 0x18: // clc
+    case 0x38: // sec
+      writes = LOCC;
+      break;
+    case 0xb8: // clv
+      writes = LOCV;
+      break;
+    case 0xea: // nop
+      break;
+    default:
+      return false;
+    }
+    if (memread || memwrite) {
+      // immediate, zero page or absolute addressing
+      uint8_t mode = opcode & 0x0c;
+      len = (mode == 0x0c) ? 3 : 2;
+      if ((mode == 0x00) || ((mode == 0x08) && (opcode & 0x01))) {
+        // immediate
+        memread = false;
+      }
+    }
+    readfirst |= reads & ~written;
+    written |= writes;
+    if (memread || memwrite) {
+      uint16_t memaddr = (len == 3) ? (instr[1] + (instr[2] << 8)) : instr[1];
+      if (memread) {
+        // no side effects, value constant until the next rasterline (VIC
+        // registers: until the rasterline is drawn)
+        if ((memaddr >= 0xd000) && (memaddr <= 0xdfff) &&
+            (readPages[memaddr >> 8] == nullptr)) {
+          uint8_t vicidx = (memaddr - 0xd000) % 0x40;
+          if ((memaddr > 0xd3ff) || (vicidx == 0x1e) || (vicidx == 0x1f)) {
+            return false;
+          }
+          loopreadsio = true;
+        }
+        bool iswritten = false;
+        for (uint8_t i = 0; i < nummemwritten; i++) {
+          if (memwritten[i] == memaddr) {
+            iswritten = true;
+          }
+        }
+        if (!iswritten) {
+          if (nummemreadfirst == MAXMEMLOCS) {
+            return false;
+          }
+          memreadfirst[nummemreadfirst++] = memaddr;
+        }
+      } else {
+        // ram only, no self modifying code
+        if ((memaddr <= 0x0001) ||
+            ((memaddr >= 0xd000) && (memaddr <= 0xdfff)) ||
+            ((memaddr >= startaddr) && (memaddr <= branchaddr + 2))) {
+          return false;
+        }
+        if (nummemwritten == MAXMEMLOCS) {
+          return false;
+        }
+        memwritten[nummemwritten++] = memaddr;
+      }
+    }
+    addr += len;
+  }
+  if (readfirst & written) {
+    return false;
+  }
+  for (uint8_t i = 0; i < nummemreadfirst; i++) {
+    for (uint8_t j = 0; j < nummemwritten; j++) {
+      if (memreadfirst[i] == memwritten[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool C64Sys::isCopyFillLoop(uint16_t startaddr, uint16_t branchaddr) {
+  // copy loop: lda abs,x; sta abs,x [; sta abs,x ...]; dex / inx; bne
+  // fill loop: sta abs,x [; sta abs,x ...]; dex / inx; bne
+  // (or indexed by register y)
+  static const uint8_t MINLOOPLEN = 3 + 1;
+  static const uint8_t MAXLOOPLEN = 3 + 3 * MAXLOOPDST + 1;
+  if ((branchaddr < startaddr) || (branchaddr - startaddr < MINLOOPLEN) ||
+      (branchaddr - startaddr > MAXLOOPLEN)) {
+    return false;
+  }
+  const uint8_t *page = readPages[startaddr >> 8];
+  if ((page == nullptr) || ((startaddr >> 8) != ((branchaddr + 1) >> 8)) ||
+      (page[branchaddr & 0xff] != 0xd0)) {
+    return false;
+  }
+  const uint8_t *instr = page + (startaddr & 0xff);
+  const uint8_t *branch = page + (branchaddr & 0xff);
+  loopcopy = (instr[0] == 0xbd) || (instr[0] == 0xb9);
+  if (loopcopy) {
+    loopindexx = (instr[0] == 0xbd);
+    loopsrc = instr[1] + (instr[2] << 8);
+    instr += 3;
+  } else {
+    loopindexx = (instr[0] == 0x9d);
+  }
+  uint8_t staopcode = loopindexx ? 0x9d : 0x99;
+  loopnumofdst = 0;
+  while ((instr + 3 < branch) && (*instr == staopcode) &&
+         (loopnumofdst < MAXLOOPDST)) {
+    loopdst[loopnumofdst++] = instr[1] + (instr[2] << 8);
+    instr += 3;
+  }
+  if ((loopnumofdst == 0) || (instr + 1 != branch)) {
+    return false;
+  }
+  if (*instr == (loopindexx ? 0xca : 0x88)) {
+    loopdec = true;
+  } else if (*instr == (loopindexx ? 0xe8 : 0xc8)) {
+    loopdec = false;
+  } else {
+    return false;
+  }
+  // cycles of a repetition: lda, sta, dex / inx, bne (branch taken)
+  loopbasecycles = (loopcopy ? 4 : 0) + 5 * loopnumofdst + 2 + 3;
+  if (((branchaddr + 2) & 0xff00) != (startaddr & 0xff00)) {
+    loopbasecycles++;
+  }
+  return true;
+}
+
+uint8_t C64Sys::loopLimit() {
+  // repetitions of a loop may be executed or skipped up to this cycle (the
+  // next event never lies before the actual cycle, see scheduleNextEvent)
+  return (nextevent < numofcyclestoexe) ? nextevent : numofcyclestoexe;
+}
+
+void C64Sys::executeCopyFillLoop(uint16_t startaddr, uint16_t branchaddr) {
+  // execute the repetitions of the loop (except the last one) up to the next
+  // event directly via the page tables, stop at i/o pages, registers 0 and 1
+  // and the code of the loop
+  uint8_t limit = loopLimit();
+  uint8_t idx = loopindexx ? x : y;
+  uint8_t val = a;
+  uint16_t cycles = numofcycles;
+  uint16_t lastaddr = z;
+  while (loopdec ? (idx > 1) : (idx < 0xff)) {
+    // page crossing of lda is determined relative to the effective address
+    // of the previous instruction (as done by the cpu core)
+    uint16_t srcaddr = loopsrc + idx;
+    uint8_t itercycles = loopbasecycles;
+    if (loopcopy && ((lastaddr & 0xff00) != (srcaddr & 0xff00))) {
+      itercycles++;
+    }
+    if (cycles + itercycles > limit) {
+      break;
+    }
+    uint8_t *dstpage[MAXLOOPDST];
+    bool ok = true;
+    for (uint8_t i = 0; i < loopnumofdst; i++) {
+      uint16_t addr = loopdst[i] + idx;
+      dstpage[i] = writePages[addr >> 8];
+      if ((dstpage[i] == nullptr) || (addr <= 0x0001) ||
+          ((addr >= startaddr) && (addr <= branchaddr + 1))) {
+        ok = false;
+      }
+    }
+    if (!ok) {
+      break;
+    }
+    if (loopcopy) {
+      const uint8_t *srcpage = readPages[srcaddr >> 8];
+      if (srcpage == nullptr) {
+        break;
+      }
+      val = srcpage[srcaddr & 0xff];
+    }
+    for (uint8_t i = 0; i < loopnumofdst; i++) {
+      dstpage[i][(loopdst[i] + idx) & 0xff] = val;
+    }
+    lastaddr = loopdst[loopnumofdst - 1] + idx;
+    cycles += itercycles;
+    idx = loopdec ? idx - 1 : idx + 1;
+  }
+  if (cycles == numofcycles) {
+    return;
+  }
+  // state after the last executed repetition
+  zl = loopdst[loopnumofdst - 1] & 0xff;
+  zh = loopdst[loopnumofdst - 1] >> 8;
+  z = lastaddr;
+  numofcopyfillcycles += cycles - numofcycles;
+  numofcycles = cycles;
+  if (loopindexx) {
+    x = idx;
+  } else {
+    y = idx;
+  }
+  a = val;
+  setZ(idx);
+  setN(idx);
+  loopcycles = numofcycles;
+}
+
+void C64Sys::analyzeLoop(uint16_t branchaddr) {
+  // first repetition of the loop
+  loopvalid = true;
+  loopbranchaddr = branchaddr;
+  loopcycles = numofcycles;
+  loopidle = (!debug) && isIdleLoop(pc, branchaddr);
+  loopcopyfill = (!debug) && (!loopidle) && isCopyFillLoop(pc, branchaddr);
+  if (loopcopyfill) {
+    executeCopyFillLoop(pc, branchaddr);
+  }
+}
+
+void C64Sys::loopBranch(uint16_t branchaddr) {
+  if ((!loopvalid) || (branchaddr != loopbranchaddr)) {
+    analyzeLoop(branchaddr);
+    return;
+  }
+  if (loopcopyfill) {
+    executeCopyFillLoop(pc, branchaddr);
+    return;
+  }
+  if (!loopidle) {
+    return;
+  }
+  // the loop has been executed completely without any change of its input
+  // values, skip as many repetitions as possible before the next event
+  uint8_t looplen = numofcycles - loopcycles;
+  uint8_t limit = loopLimit();
+  if (numofcycles + looplen < limit) {
+    uint8_t skipcycles = ((limit - 1 - numofcycles) / looplen) * looplen;
+    numofcycles += skipcycles;
+    numofidlecycles += skipcycles;
   }
+  loopcycles = numofcycles;
 }
 
 void C64Sys::logDebugInfo() {
@@ -763,6 +1212,49 @@ void C64Sys::check4extcmd() {
   }
 }
 
+uint8_t C64Sys::executeNextInstr() {
+  uint8_t opcode = getMem(pc++);
+  execute(opcode);
+  return opcode;
+}
+
+void C64Sys::nextFrame(uint32_t busyus) {
+  // adaptive frame skipping: the number of skipped frames is adapted at the
+  // end of each cycle of a drawn frame and its skipped frames, it is
+  // increased if the emulation of the cycle took longer than real time and
+  // decreased if the emulation would keep up with real time (with 10 %
+  // headroom) when drawing one more frame
+  if (vic.drawframe) {
+    drawnbusyus = busyus;
+  } else if (busyus > skippedbusyus) {
+    skippedbusyus = busyus;
+  }
+  uint8_t skip = warp ? WARPFRAMESKIP - 1 : frameskip;
+  if (skipframecnt < skip) {
+    skipframecnt++;
+    vic.drawframe = false;
+    return;
+  }
+  if (throttle && (!warp)) {
+    uint32_t avgbusyus = (drawnbusyus + skip * skippedbusyus) / (skip + 1);
+    if (avgbusyus > FRAMEUS) {
+      if (frameskip < MAXFRAMESKIP) {
+        frameskip++;
+      }
+    } else if (frameskip > 0) {
+      uint32_t predictedbusyus =
+          (drawnbusyus + (skip - 1) * skippedbusyus) / skip;
+      if (predictedbusyus * 10 < FRAMEUS * 9) {
+        frameskip--;
+      }
+    }
+    frameskiplevel.store(frameskip, std::memory_order_release);
+  }
+  skipframecnt = 0;
+  skippedbusyus = 0;
+  vic.drawframe = true;
+}
+
 void C64Sys::run() {
   // pc *must* be set externally!
   cpuhalted = false;
@@ -777,6 +1269,9 @@ void C64Sys::run() {
   while (true) {
     // cpu halted?
     if (cpuhalted) {
+      if (numofframestorun != 0) {
+        return;
+      }
       PlatformManager::getInstance().waitMS(500);
       check4extcmd();
       continue;
@@ -790,41 +1285,41 @@ void C64Sys::run() {
 
     // calculate number of cycles to execute
     numofcycles = 0;
-    int8_t numofcyclestoexe = 63 - badlinecycles - adjustcycles;
-    if (numofcyclestoexe < 0) {
-      numofcyclestoexe = 0;
-    }
-
-    // execute CPU cycles and check CIA timers
-    while (numofcycles < numofcyclestoexe / 2) {
-      if (cpuhalted) {
-        break;
-      }
-      logDebugInfo();
-      execute(getMem(pc++));
-      // check interrupt request (VIC or CIA) nach jedem Befehl
-      if ((vic.vicreg[0x19] & 0x81) && (vic.vicreg[0x1a] & 1) && (!iflag)) {
-        setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
-      }
-    }
-    checkciatimers(31);
+    int8_t cycles = 63 - badlinecycles - adjustcycles;
+    numofcyclestoexe = (cycles < 0) ? 0 : cycles;
 
-    // draw rasterline
-    vic.drawRasterline();
+    // the CIA timers also count the cycles used by the VIC
+    cia1.advanceTimers(badlinecycles);
+    cia2.advanceTimers(badlinecycles);
+    ciasynccycles = 0;
+    drawcycle = numofcyclestoexe / 2;
+    linedrawn = false;
+    nextevent = 0;
+    loopvalid = false;
+    numofidlecycles = 0;
+    numofcopyfillcycles = 0;
 
-    // execute CPU cycles and check CIA timers
+    // execute CPU cycles, handle events (interrupt requests, CIA timer
+    // underflows, drawing of the rasterline)
     while (numofcycles < numofcyclestoexe) {
+      if (numofcycles >= nextevent) {
+        handleEvents();
+      }
       if (cpuhalted) {
         break;
       }
       logDebugInfo();
-      execute(getMem(pc++));
-      // check interrupt request (VIC or CIA) nach jedem Befehl
-      if ((vic.vicreg[0x19] & 0x81) && (vic.vicreg[0x1a] & 1) && (!iflag)) {
-        setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), false);
-      }
+      executeNextInstr();
     }
-    checkciatimers(32);
+
+    // end of rasterline
+    if (!linedrawn) {
+      vic.drawRasterline();
+    }
+    syncCIAs();
+    cia1.checkAlarm();
+    cia2.checkAlarm();
+    checkInterrupts();
     adjustcycles = numofcycles - numofcyclestoexe;
 
     // sprite collision interrupt?
@@ -844,21 +1339,43 @@ void C64Sys::run() {
 
     // "throttle"
     numofcyclespersecond.fetch_add(numofcycles, std::memory_order_release);
+    if (numofidlecycles != 0) {
+      numofidlecyclespersecond.fetch_add(numofidlecycles,
+                                         std::memory_order_release);
+    }
+    if (numofcopyfillcycles != 0) {
+      numofcopyfillcyclespersecond.fetch_add(numofcopyfillcycles,
+                                             std::memory_order_release);
+    }
     int64_t nominaltime =
         lastMeasuredTime + ((vic.rasterline + 1) * 1000000 / 50 / 312);
     int64_t now = PlatformManager::getInstance().getTimeUS();
-    if (nominaltime > now) {
+    if (throttle && (!warp) && (nominaltime > now)) {
       int64_t us = nominaltime - now;
       numofburnedcyclespersecond.fetch_add(us, std::memory_order_release);
+      frameburnedus += us;
       PlatformManager::getInstance().waitUS(us);
     }
 
     // get start time of frame, play audio
     if (vic.rasterline == 311) {
-      lastMeasuredTime = PlatformManager::getInstance().getTimeUS();
-      sid.playAudio();
+      now = PlatformManager::getInstance().getTimeUS();
+      int64_t frameus = now - lastMeasuredTime;
+      uint32_t busyus = (frameus > frameburnedus) ? frameus - frameburnedus : 0;
+      lastMeasuredTime = now;
+      frameburnedus = 0;
+      // in warp mode only the drawn frames are played
+      if ((!warp) || vic.drawframe) {
+        sid.playAudio();
+      } else {
+        sid.discardAudio();
+      }
+      nextFrame(busyus);
       // check for "external commands" once per frame
       check4extcmd();
+      if ((numofframestorun != 0) && (--numofframestorun == 0)) {
+        return;
+      }
     }
   }
 }
@@ -907,14 +1424,43 @@ void C64Sys::init(uint8_t *ram, const uint8_t *charrom) {
   floppy.init(8);
   this->ram = ram;
   this->charrom = charrom;
+  // memory map: ram pages (writes to registers 0 and 1 are handled by
+  // setIOMem()), the banked areas are set by decodeRegister1()
+  for (uint16_t page = 0; page <= 0xff; page++) {
+    readPages[page] = ram + (page << 8);
+    writePages[page] = ram + (page << 8);
+  }
+  register1 = 0x37;
+  decodeRegister1(register1 & 7);
   this->externalCmds = new ExternalCmds();
   this->hooks = new Hooks();
   joystickmode = 0;
   kbjoystickmode = 0;
   deactivateTemp = false;
+  warp = false;
+  frameskip = 0;
+  skipframecnt = 0;
+  frameburnedus = 0;
+  drawnbusyus = 0;
+  skippedbusyus = 0;
+  throttle = true;
+  numofframestorun = 0;
   numofcycles = 0;
+  ciasynccycles = 0;
+  nextevent = 0;
+  drawcycle = 0;
+  linedrawn = true;
+  numofcyclestoexe = 0;
+  loopvalid = false;
+  loopreadsio = false;
+  numofidlecycles = 0;
+  loopcopyfill = false;
+  numofcopyfillcycles = 0;
   numofcyclespersecond.store(0, std::memory_order_release);
   numofburnedcyclespersecond.store(0, std::memory_order_release);
+  numofidlecyclespersecond.store(0, std::memory_order_release);
+  numofcopyfillcyclespersecond.store(0, std::memory_order_release);
+  frameskiplevel.store(0, std::memory_order_release);
   perf.store(false, std::memory_order_release);
   batteryVoltage.store(0, std::memory_order_release);
   poweroff.store(false, std::memory_order_release);
@@ -953,8 +1499,7 @@ void C64Sys::exeSubroutine(uint16_t regpc) {
   uint8_t tsp = sp;
   pc = regpc;
   while (true) {
-    uint8_t nextopc = getMem(pc++);
-    execute(nextopc);
+    uint8_t nextopc = executeNextInstr();
     if ((sp == tsp) && (nextopc == 0x60)) { // rts
       break;
     }
@@ -964,11 +1509,11 @@ void C64Sys::exeSubroutine(uint16_t regpc) {
 void C64Sys::exeSubroutine(uint16_t addr, uint8_t rega, uint8_t regx,
                            uint8_t regy) {
   bool tcflag = cflag;
-  bool tzflag = zflag;
+  bool tzflag = getZFlag();
   bool tdflag = dflag;
   bool tbflag = bflag;
   bool tvflag = vflag;
-  bool tnflag = nflag;
+  bool tnflag = getNFlag();
   bool tiflag = iflag;
   uint8_t ta = a;
   uint8_t tx = x;
@@ -981,23 +1526,22 @@ void C64Sys::exeSubroutine(uint16_t addr, uint8_t rega, uint8_t regx,
   a = rega;
   x = regx;
   y = regy;
-  ram[0x033c] = 0x20; // jsr
-  ram[0x033d] = addr & 0xff;
-  ram[0x033e] = addr >> 8;
+  setMem(0x033c, 0x20); // jsr
+  setMem(0x033d, addr & 0xff);
+  setMem(0x033e, addr >> 8);
   pc = 0x033c;
   while (true) {
-    uint8_t nextopc = getMem(pc++);
-    execute(nextopc);
+    uint8_t nextopc = executeNextInstr();
     if ((sp == tsp) && (nextopc == 0x60)) { // rts
       break;
     }
   }
   cflag = tcflag;
-  zflag = tzflag;
+  setZ(!tzflag);
   dflag = tdflag;
   bflag = tbflag;
   vflag = tvflag;
-  nflag = tnflag;
+  setN(tnflag ? 0x80 : 0);
   iflag = tiflag;
   a = ta;
   x = tx;
@@ -1016,3 +1560,6 @@ void C64Sys::scanKeyboard() {
     }
   }
 }
+
+// explicit instantiation of the cpu core with C64Sys as memory bus
+template class CPU6502<C64Sys>;
@@ -36,19 +36,68 @@ class ExternalCmds; // forward declaration
 
 enum class JoystickOnlyModeState { NONE, CHOOSEFILE, RUN, INGAME };
 
-class C64Sys : public CPU6502, public IDebugBus {
+class C64Sys : public CPU6502<C64Sys>, public IDebugBus {
 private:
   uint8_t *ram;
   uint8_t *kernalrom;
   const uint8_t *charrom;
   JoystickDriver *joystick;
 
-  bool bankARAM;
-  bool bankDRAM;
-  bool bankERAM;
-  bool bankDIO;
+  // memory map: pointer to each page (256 bytes) of ram / rom, rebuilt by
+  // decodeRegister1(); nullptr -> i/o page, handled by getIOMem() / setIOMem()
+  const uint8_t *readPages[256];
+  uint8_t *writePages[256];
   uint8_t register1;
 
+  // event scheduling within a rasterline (in cpu cycles): next event (CIA
+  // timer underflow requesting an interrupt, drawing of the rasterline, check
+  // for a pending interrupt after a register write or cli), number of cycles
+  // the CIAs are synchronized to, cycle to draw the rasterline
+  uint8_t nextevent;
+  uint8_t ciasynccycles;
+  uint8_t drawcycle;
+  bool linedrawn;
+  uint8_t numofcyclestoexe;
+
+  // idle loop detection: last loop branch taken (valid until an interrupt or
+  // the next rasterline), cycle at which it was taken, loop is an idle loop
+  // (repeating the loop does not change the state of the emulator), loop
+  // reads VIC registers, number of skipped cycles
+  bool loopvalid;
+  uint16_t loopbranchaddr;
+  uint8_t loopcycles;
+  bool loopidle;
+  bool loopreadsio;
+  uint16_t numofidlecycles;
+
+  // copy / fill loop detection: loop is a copy / fill loop, index register,
+  // decrement / increment of the index register, load from source address
+  // (copy loop), destination addresses, cycles of a repetition (without page
+  // crossing), number of cycles executed natively
+  static const uint8_t MAXLOOPDST = 4;
+  bool loopcopyfill;
+  bool loopindexx;
+  bool loopdec;
+  bool loopcopy;
+  uint16_t loopsrc;
+  uint16_t loopdst[MAXLOOPDST];
+  uint8_t loopnumofdst;
+  uint8_t loopbasecycles;
+  uint16_t numofcopyfillcycles;
+
+  // frame skipping: after each drawn frame "frameskip" frames are emulated
+  // but not drawn (in warp mode WARPFRAMESKIP - 1 frames), counter of the
+  // skipped frames, time waited in the actual frame, busy time of the last
+  // drawn frame and of the slowest skipped frame (us)
+  static const uint8_t WARPFRAMESKIP = 10;
+  static const uint8_t MAXFRAMESKIP = 3;
+  static const uint16_t FRAMEUS = 1000000 / 50;
+  uint8_t frameskip;
+  uint8_t skipframecnt;
+  uint32_t frameburnedus;
+  uint32_t drawnbusyus;
+  uint32_t skippedbusyus;
+
   bool nmiAck;
 
   uint8_t joystickOnlyModeCnt;
@@ -73,9 +122,21 @@ private:
   uint8_t listInGameKeycodesIdx;
 
   uint8_t getDC01(uint8_t dc00, bool xchgports);
+  uint8_t getIOMem(uint16_t addr);
+  void setIOMem(uint16_t addr, uint8_t val);
   inline void adaptVICBaseAddrs(bool fromcia) __attribute__((always_inline));
   inline void decodeRegister1(uint8_t val) __attribute__((always_inline));
-  inline void checkciatimers(uint8_t cycles) __attribute__((always_inline));
+  inline uint8_t executeNextInstr() __attribute__((always_inline));
+  inline void syncCIAs() __attribute__((always_inline));
+  inline void checkInterrupts() __attribute__((always_inline));
+  void handleEvents();
+  void scheduleNextEvent();
+  bool isIdleLoop(uint16_t startaddr, uint16_t branchaddr);
+  bool isCopyFillLoop(uint16_t startaddr, uint16_t branchaddr);
+  void executeCopyFillLoop(uint16_t startaddr, uint16_t branchaddr);
+  void analyzeLoop(uint16_t branchaddr);
+  inline uint8_t loopLimit() __attribute__((always_inline));
+  void nextFrame(uint32_t busyus);
   inline void logDebugInfo() __attribute__((always_inline));
   JoystickOnlyTextKeycode getNextKeycode();
   void getJoystickValues();
@@ -106,6 +167,9 @@ public:
 
   std::atomic<uint32_t> numofcyclespersecond;
   std::atomic<uint32_t> numofburnedcyclespersecond;
+  std::atomic<uint32_t> numofidlecyclespersecond;
+  std::atomic<uint32_t> numofcopyfillcyclespersecond;
+  std::atomic<uint8_t> frameskiplevel;
   std::atomic<bool> perf;
   std::atomic<uint16_t> batteryVoltage;
   std::atomic<bool> poweroff;
@@ -118,6 +182,7 @@ public:
   uint8_t joystickmode;
   uint8_t kbjoystickmode;
   bool deactivateTemp;
+  bool warp;
   bool debug;
   uint16_t debugstartaddr;
   long debugNumOfSteps;
@@ -126,8 +191,17 @@ public:
 
   bool restorenmi;
 
-  uint8_t getMem(uint16_t addr) override;
-  void setMem(uint16_t addr, uint8_t val) override;
+  // set by c64bench: run without throttling and return from run() after the
+  // given number of frames (0 = run forever)
+  bool throttle;
+  uint32_t numofframestorun;
+
+  uint8_t getMem(uint16_t addr) final;
+  void setMem(uint16_t addr, uint8_t val) final;
+  // check for a pending interrupt request after the actual instruction
+  inline void irqEnabled() __attribute__((always_inline)) { nextevent = 0; }
+  // skip repetitions of an idle loop up to the next event
+  inline void loopBranch(uint16_t branchaddr) __attribute__((always_inline));
   void cmd6502brk() override;
   void cmd6502halt() override;
   void run() override;
@@ -140,6 +214,11 @@ public:
   void exeSubroutine(uint16_t addr, uint8_t rega, uint8_t regx, uint8_t regy);
   void exeSubroutine(uint16_t regpc);
   void scanKeyboard();
+#ifdef LINUX_BENCH
+  // check of the event scheduling with all CIA interrupts masked: the next
+  // event must lie after the actual cycle for each cycle of a rasterline
+  bool checkEventScheduling();
+#endif
 };
 
 #endif // C64SYS_H
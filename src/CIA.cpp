@@ -28,86 +28,116 @@ void CIA::checkAlarm() {
   }
 }
 
-void CIA::checkTimerA(uint8_t deltaT) {
+void CIA::underflowA() {
   uint8_t reg0e = ciareg[0x0e];
-  if (!(reg0e & 1)) {
-    // timer stopped
-    return;
+  if (reg0e & 0x02) {
+    if (!(reg0e & 0x04)) {
+      ciareg[0x01] ^= 0x40;
+    }
+    // ignore "toggle bit for one cycle"
   }
-  if (reg0e & 0x20) {
-    // timer clocked by CNT pin
-    return;
+  latchdc0d |= 0x01;
+  if (!(reg0e & 8)) {
+    timerA = (latchdc05 << 8) + latchdc04;
+  } else {
+    ciareg[0x0e] &= 0xfe;
+  }
+  if (ciareg[0x0d] & 1) {
+    latchdc0d |= 0x80;
   }
-  int32_t tmp = timerA - deltaT;
-  timerA = (tmp < 0) ? 0 : tmp;
-  if (timerA == 0) {
-    underflowTimerA = true;
-    if (reg0e & 0x02) {
-      if (!(reg0e & 0x04)) {
-        ciareg[0x01] ^= 0x40;
+  if ((ciareg[0x0e] & 0x40) && (serbitnr != 0)) {
+    serbitnr--;
+    if (serbitnr == 0) {
+      latchdc0d |= 0x08;
+      if (ciareg[0x0d] & 8) {
+        latchdc0d |= 0x80;
       }
-      // ignore "toggle bit for one cycle"
-    }
-    latchdc0d |= 0x01;
-    if (!(reg0e & 8)) {
-      timerA = (latchdc05 << 8) + latchdc04;
-    } else {
-      ciareg[0x0e] &= 0xfe;
-    }
-    if (ciareg[0x0d] & 1) {
-      latchdc0d |= 0x80;
-    }
-    if ((ciareg[0x0e] & 0x40) && (serbitnr != 0)) {
-      serbitnr--;
-      if (serbitnr == 0) {
-        latchdc0d |= 0x08;
-        if (ciareg[0x0d] & 8) {
-          latchdc0d |= 0x80;
-        }
-        if (serbitnrnext != 0) {
-          serbitnr = serbitnrnext;
-          serbitnrnext = 0;
-        }
+      if (serbitnrnext != 0) {
+        serbitnr = serbitnrnext;
+        serbitnrnext = 0;
       }
     }
   }
+  // timer B counts underflows of timer A?
+  if ((ciareg[0x0f] & 0x61) == 0x41) {
+    timerB--;
+    if (timerB == 0) {
+      underflowB();
+    }
+  }
 }
 
-void CIA::checkTimerB(uint8_t deltaT) {
+void CIA::underflowB() {
   uint8_t reg0f = ciareg[0x0f];
-  if (!(reg0f & 1)) {
-    // timer stopped
-    return;
-  }
-  uint8_t bit56 = ciareg[0x0f] & 0x60;
-  if (bit56 == 0) {
-    int32_t tmp = timerB - deltaT;
-    timerB = (tmp < 0) ? 0 : tmp;
-  } else if (bit56 == 0x40) {
-    if (underflowTimerA) {
-      underflowTimerA = false;
-      timerB--;
+  if (reg0f & 0x02) {
+    if (!(reg0f & 0x04)) {
+      ciareg[0x01] ^= 0x80;
     }
+    // ignore "toggle bit for one cycle"
+  }
+  latchdc0d |= 0x02;
+  if (!(reg0f & 8)) {
+    timerB = (latchdc07 << 8) + latchdc06;
   } else {
+    ciareg[0x0f] &= 0xfe;
+  }
+  if (ciareg[0x0d] & 2) {
+    latchdc0d |= 0x80;
+  }
+}
+
+void CIA::advanceTimers(uint16_t deltaT) {
+  if (deltaT == 0) {
     return;
   }
-  if (timerB == 0) {
-    if (reg0f & 0x02) {
-      if (!(reg0f & 0x04)) {
-        ciareg[0x01] ^= 0x80;
-      }
-      // ignore "toggle bit for one cycle"
+  // timer A (if started and not clocked by CNT pin), a timer value of 0
+  // underflows after one cycle
+  uint16_t cycles = deltaT;
+  while ((ciareg[0x0e] & 0x21) == 0x01) {
+    uint16_t cnt = (timerA == 0) ? 1 : timerA;
+    if (cycles < cnt) {
+      timerA -= cycles;
+      break;
     }
-    latchdc0d |= 0x02;
-    if (!(reg0f & 8)) {
-      timerB = (latchdc07 << 8) + latchdc06;
-    } else {
-      ciareg[0x0f] &= 0xfe;
+    cycles -= cnt;
+    timerA = 0;
+    underflowA();
+  }
+  // timer B (if started and clocked by phi2)
+  cycles = deltaT;
+  while ((ciareg[0x0f] & 0x61) == 0x01) {
+    uint16_t cnt = (timerB == 0) ? 1 : timerB;
+    if (cycles < cnt) {
+      timerB -= cycles;
+      break;
     }
-    if (ciareg[0x0d] & 2) {
-      latchdc0d |= 0x80;
+    cycles -= cnt;
+    timerB = 0;
+    underflowB();
+  }
+}
+
+uint16_t CIA::cyclesToInterrupt() {
+  if (latchdc0d & 0x80) {
+    // interrupt already requested
+    return 0xffff;
+  }
+  uint16_t cycles = 0xffff;
+  uint8_t mask = ciareg[0x0d];
+  uint8_t reg0e = ciareg[0x0e];
+  uint8_t reg0f = ciareg[0x0f];
+  // timer A underflows may cause a timer A, serial or timer B interrupt
+  if (((reg0e & 0x21) == 0x01) &&
+      ((mask & 0x09) || ((mask & 0x02) && ((reg0f & 0x61) == 0x41)))) {
+    cycles = (timerA == 0) ? 1 : timerA;
+  }
+  if (((reg0f & 0x61) == 0x01) && (mask & 0x02)) {
+    uint16_t cyclesB = (timerB == 0) ? 1 : timerB;
+    if (cyclesB < cycles) {
+      cycles = cyclesB;
     }
   }
+  return cycles;
 }
 
 void CIA::init(bool isCIA1) {
@@ -115,7 +145,6 @@ void CIA::init(bool isCIA1) {
     ciareg[i] = 0;
   }
 
-  underflowTimerA = false;
   serbitnr = 0;
   serbitnrnext = 0;
   latchdc04 = 0;
@@ -28,11 +28,12 @@
 class CIA {
 private:
   bool updateTODInt();
+  void underflowA();
+  void underflowB();
 
 public:
   uint8_t ciareg[0x10];
 
-  bool underflowTimerA;
   uint8_t serbitnr;
   uint8_t serbitnrnext;
   uint8_t latchdc04;
@@ -58,8 +59,12 @@ public:
   CIA(bool isCIA1);
   void init(bool isCIA1);
   void checkAlarm();
-  void checkTimerA(uint8_t deltaT);
-  void checkTimerB(uint8_t deltaT);
+  // advance the timers by the given number of cycles (timer B counting
+  // underflows of timer A is advanced by timer A)
+  void advanceTimers(uint16_t deltaT);
+  // number of cycles until the next timer underflow which may request an
+  // interrupt (0xffff: no such underflow)
+  uint16_t cyclesToInterrupt();
   uint8_t getCommonCIAReg(uint8_t ciaidx);
   void setCommonCIAReg(uint8_t ciaidx, uint8_t val);
   void updateTOD();
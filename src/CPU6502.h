@@ -17,14 +17,119 @@
 #ifndef CPU6502_H
 #define CPU6502_H
 
+#include "Config.h"
 #include <cstdint>
 
-class CPU6502 {
-private:
-  uint8_t zl;
-  uint8_t zh;
-  uint16_t z;
+// names of the 6502 opcodes (used for logging), shared by all cpu instances
+class CPU6502CmdNames {
+protected:
+  static constexpr const char *cmdName[256] = {
+      // 0x00
+      "brk", "oraIndirectX", "hlt", "asoIndirectX", "nopZeropage",
+      "oraZeropage", "aslZeropage", "asoZeropage", "php", "oraImmediate",
+      "aslA", "ancImmediate", "skwAbsolute", "oraAbsolute", "aslAbsolute",
+      "asoAbsolute",
+      // 0x10
+      "bpl", "oraIndirectY", "hlt", "asoIndirectY", "nopZeropageX",
+      "oraZeropageX", "aslZeropageX", "asoZeropageX", "clc", "oraAbsoluteY",
+      "nop1a", "asoAbsoluteY", "skwAbsoluteX", "oraAbsoluteX", "aslAbsoluteX",
+      "asoAbsoluteX",
+      // 0x20
+      "jsr", "andIndirectX", "hlt", "rlaIndirectX", "bitZeropage",
+      "andZeropage", "rolZeropage", "rlaZeropage", "plp", "andImmediate",
+      "rolA", "ancImmediate", "bitAbsolute", "andAbsolute", "rolAbsolute",
+      "rlaAbsolute",
+      // 0x30
+      "bmi", "andIndirectY", "hlt", "rlaIndirectY", "nopZeropageX",
+      "andZeropageX", "rolZeropageX", "rlaZeropageX", "sec", "andAbsoluteY",
+      "nop3a", "rlaAbsoluteY", "skwAbsoluteX", "andAbsoluteX", "rolAbsoluteX",
+      "rlaAbsoluteX",
+      // 0x40
+      "rti", "eorIndirectX", "hlt", "sreIndirectX", "nopZeropage",
+      "eorZeropage", "lsrZeropage", "sreZeropage", "pha", "eorImmediate",
+      "lsrA", "alrImmediate", "jmpAbsolute", "eorAbsolute", "lsrAbsolute",
+      "sreAbsolute",
+      // 0x50
+      "bvc", "eorIndirectY", "hlt", "sreIndirectY", "nopZeropageX",
+      "eorZeropageX", "lsrZeropageX", "sreZeropageX", "cli", "eorAbsoluteY",
+      "nop5a", "sreAbsoluteY", "skwAbsoluteX", "eorAbsoluteX", "lsrAbsoluteX",
+      "sreAbsoluteX",
+      // 0x60
+      "rts", "adcIndirectX", "hlt", "rraIndirectX", "nopZeropage",
+      "adcZeropage", "rorZeropage", "rraZeropage", "pla", "adcImmediate",
+      "rorA", "arr", "jmpIndirect", "adcAbsolute", "rorAbsolute", "rraAbsolute",
+      // 0x70
+      "bvs", "adcIndirectY", "hlt", "rraIndirectY", "nopZeropageX",
+      "adcZeropageX", "rorZeropageX", "rraZeropageX", "sei", "adcAbsoluteY",
+      "nop7a", "rraAbsoluteY", "skwAbsoluteX", "adcAbsoluteX", "rorAbsoluteX",
+      "rraAbsoluteX",
+      // 0x80
+      "nopImmediate", "staIndirectX", "nopImmediate", "saxIndirectX",
+      "styZeropage", "staZeropage", "stxZeropage", "saxZeropage", "dey",
+      "nopImmediate", "txa", "xaaImmediate", "styAbsolute", "staAbsolute",
+      "stxAbsolute", "saxAbsolute",
+      // 0x90
+      "bcc", "staIndirectY", "hlt", "shaZeropageY", "styZeropageX",
+      "staZeropageX", "stxZeropageY", "saxZeropageY", "tya", "staAbsoluteY",
+      "txs", "tas", "shy", "staAbsoluteX", "shxAbsoluteY", "shaAbsoluteY",
+      // 0xa0
+      "ldyImmediate", "ldaIndirectX", "ldxImmediate", "laxIndirectX",
+      "ldyZeropage", "ldaZeropage", "ldxZeropage", "laxZeropage", "tay",
+      "ldaImmediate", "tax", "lxaImmediate", "ldyAbsolute", "ldaAbsolute",
+      "ldxAbsolute", "laxAbsolute",
+      // 0xb0
+      "bcs", "ldaIndirectY", "hlt", "laxIndirectY", "ldyZeropageX",
+      "ldaZeropageX", "ldxZeropageY", "laxZeropageY", "clv", "ldaAbsoluteY",
+      "tsx", "lasAbsolute", "ldyAbsoluteX", "ldaAbsoluteX", "ldxAbsoluteY",
+      "laxAbsoluteY",
+      // 0xc0
+      "cpyImmediate", "cmpIndirectX", "nopImmediate", "dcpIndirectX",
+      "cpyZeropage", "cmpZeropage", "decZeropage", "dcpZeropage", "iny",
+      "cmpImmediate", "dex", "sbxImmediate", "cpyAbsolute", "cmpAbsolute",
+      "decAbsolute", "dcpAbsolute",
+      // 0xd0
+      "bne", "cmpIndirectY", "hlt", "dcpIndirectY", "nopZeropageX",
+      "cmpZeropageX", "decZeropageX", "dcpZeropageX", "cld", "cmpAbsoluteY",
+      "nopda", "dcpAbsoluteY", "skwAbsoluteX", "cmpAbsoluteX", "decAbsoluteX",
+      "dcpAbsoluteX",
+      // 0xe0
+      "cpxImmediate", "sbcIndirectX", "nopImmediate", "isbIndirectX",
+      "cpxZeropage", "sbcZeropage", "incZeropage", "isbZeropage", "inx",
+      "sbcImmediate", "nop", "sbcImmediate", "cpxAbsolute", "sbcAbsolute",
+      "incAbsolute", "isbAbsolute",
+      // 0xf0
+      "beq", "sbcIndirectY", "hlt", "isbIndirectY", "nopZeropageX",
+      "sbcZeropageX", "incZeropageX", "isbZeropageX", "sed", "sbcAbsoluteY",
+      "nopfa", "isbAbsoluteY", "skwAbsoluteX", "sbcAbsoluteX", "incAbsoluteX",
+      "isbAbsoluteX"};
+};
 
+// 6502 cpu core
+//
+// The memory bus is given as template parameter (CRTP): Bus derives from
+// CPU6502<Bus> and implements getMem() and setMem() as final methods. So the
+// opcode methods call the memory methods of Bus directly and the compiler is
+// able to inline them into the addressing mode methods.
+// The virtual methods getMem(), setMem() and run() remain as interface for
+// debugging and hooks.
+// The method definitions are found in CPU6502Impl.h, the cpu is explicitly
+// instantiated in the compilation unit of Bus.
+template <typename Bus> class CPU6502 : public CPU6502CmdNames {
+private:
+  inline uint8_t readMem(uint16_t addr) __attribute__((always_inline)) {
+    return static_cast<Bus *>(this)->getMem(addr);
+  }
+  inline void writeMem(uint16_t addr, uint8_t val)
+      __attribute__((always_inline)) {
+    static_cast<Bus *>(this)->setMem(addr, val);
+  }
+  inline void notifyIRQEnabled() __attribute__((always_inline)) {
+    static_cast<Bus *>(this)->irqEnabled();
+  }
+  inline void notifyLoopBranch(uint16_t branchaddr)
+      __attribute__((always_inline)) {
+    static_cast<Bus *>(this)->loopBranch(branchaddr);
+  }
   inline void modeZeropage() __attribute__((always_inline));
   inline void modeZeropageX() __attribute__((always_inline));
   inline void modeZeropageY() __attribute__((always_inline));
@@ -293,7 +398,79 @@ private:
 
   virtual void cmd6502halt();
 
-  void (CPU6502::*cmdarr6502[256])() = {
+protected:
+  // effective address of the last addressing mode (also used to determine a
+  // page crossing)
+  uint8_t zl;
+  uint8_t zh;
+  uint16_t z;
+
+  bool cflag;
+  bool dflag;
+  bool bflag;
+  bool vflag;
+  // interrupt flag
+  bool iflag;
+#ifdef USE_CPU_LAZYFLAGS
+  // lazy flags: instead of the n and z flags the result bytes the flags are
+  // derived from are stored, the flags are only evaluated when needed (branch,
+  // php, brk, interrupt)
+  uint8_t nflagres;
+  uint8_t zflagres;
+
+  inline bool getNFlag() const { return nflagres & 0x80; }
+  inline bool getZFlag() const { return !zflagres; }
+  inline void setN(uint8_t r) __attribute__((always_inline)) { nflagres = r; }
+  inline void setZ(uint8_t r) __attribute__((always_inline)) { zflagres = r; }
+#else
+  bool zflag;
+  bool nflag;
+
+  inline bool getNFlag() const { return nflag; }
+  inline bool getZFlag() const { return zflag; }
+  inline void setN(uint8_t r) __attribute__((always_inline)) {
+    nflag = r & 0x80;
+  }
+  inline void setZ(uint8_t r) __attribute__((always_inline)) { zflag = !r; }
+#endif
+
+  uint8_t a;
+  uint8_t x;
+  uint8_t y;
+  uint8_t sp;
+  uint8_t sr;
+  uint16_t pc;
+
+  void execute(uint8_t idx);
+  void setPCToIntVec(uint16_t intvect, bool intfrombrk);
+  void cmd6502rts();
+
+  // called when the interrupt disable flag is cleared (may be redefined by
+  // Bus, e.g. to check for a pending interrupt request)
+  inline void irqEnabled() __attribute__((always_inline)) {}
+
+  // called when a backward branch or jump is taken (end of a loop), branchaddr
+  // is the address of the branch instruction (may be redefined by Bus, e.g.
+  // to detect idle loops)
+  inline void loopBranch(uint16_t branchaddr) __attribute__((always_inline)) {}
+
+public:
+  // number of cycles since last adjustment
+  uint8_t numofcycles;
+
+  // stop cpu
+  bool cpuhalted;
+
+  // pure virtual methods (not used by the cpu core itself, see readMem() and
+  // writeMem())
+  virtual void run() = 0;
+  virtual uint8_t getMem(uint16_t addr) = 0;
+  virtual void setMem(uint16_t addr, uint8_t val) = 0;
+
+private:
+#ifdef USE_CPU_DISPATCH_TABLE
+  // opcode table, only used by execute() if USE_CPU_DISPATCH_TABLE is defined
+  static constexpr void (CPU6502::*cmdarr6502[256])() = {
       // 0x00
       &CPU6502::cmd6502brk, &CPU6502::cmd6502oraIndirectX,
       &CPU6502::cmd6502halt, &CPU6502::cmd6502asoIndirectX,
@@ -437,119 +614,7 @@ private:
       &CPU6502::cmd6502nopfa, &CPU6502::cmd6502isbAbsoluteY,
       &CPU6502::cmd6502skwAbsoluteX, &CPU6502::cmd6502sbcAbsoluteX,
       &CPU6502::cmd6502incAbsoluteX, &CPU6502::cmd6502isbAbsoluteX};
-
-protected:
-  const char *cmdName[256] = {
-      // 0x00
-      "brk", "oraIndirectX", "hlt", "asoIndirectX", "nopZeropage",
-      "oraZeropage", "aslZeropage", "asoZeropage", "php", "oraImmediate",
-      "aslA", "ancImmediate", "skwAbsolute", "oraAbsolute", "aslAbsolute",
-      "asoAbsolute",
-      // 0x10
-      "bpl", "oraIndirectY", "hlt", "asoIndirectY", "nopZeropageX",
-      "oraZeropageX", "aslZeropageX", "asoZeropageX", "clc", "oraAbsoluteY",
-      "nop1a", "asoAbsoluteY", "skwAbsoluteX", "oraAbsoluteX", "aslAbsoluteX",
-      "asoAbsoluteX",
-      // 0x20
-      "jsr", "andIndirectX", "hlt", "rlaIndirectX", "bitZeropage",
-      "andZeropage", "rolZeropage", "rlaZeropage", "plp", "andImmediate",
-      "rolA", "ancImmediate", "bitAbsolute", "andAbsolute", "rolAbsolute",
-      "rlaAbsolute",
-      // 0x30
-      "bmi", "andIndirectY", "hlt", "rlaIndirectY", "nopZeropageX",
-      "andZeropageX", "rolZeropageX", "rlaZeropageX", "sec", "andAbsoluteY",
-      "nop3a", "rlaAbsoluteY", "skwAbsoluteX", "andAbsoluteX", "rolAbsoluteX",
-      "rlaAbsoluteX",
-      // 0x40
-      "rti", "eorIndirectX", "hlt", "sreIndirectX", "nopZeropage",
-      "eorZeropage", "lsrZeropage", "sreZeropage", "pha", "eorImmediate",
-      "lsrA", "alrImmediate", "jmpAbsolute", "eorAbsolute", "lsrAbsolute",
-      "sreAbsolute",
-      // 0x50
-      "bvc", "eorIndirectY", "hlt", "sreIndirectY", "nopZeropageX",
-      "eorZeropageX", "lsrZeropageX", "sreZeropageX", "cli", "eorAbsoluteY",
-      "nop5a", "sreAbsoluteY", "skwAbsoluteX", "eorAbsoluteX", "lsrAbsoluteX",
-      "sreAbsoluteX",
-      // 0x60
-      "rts", "adcIndirectX", "hlt", "rraIndirectX", "nopZeropage",
-      "adcZeropage", "rorZeropage", "rraZeropage", "pla", "adcImmediate",
-      "rorA", "arr", "jmpIndirect", "adcAbsolute", "rorAbsolute", "rraAbsolute",
-      // 0x70
-      "bvs", "adcIndirectY", "hlt", "rraIndirectY", "nopZeropageX",
-      "adcZeropageX", "rorZeropageX", "rraZeropageX", "sei", "adcAbsoluteY",
-      "nop7a", "rraAbsoluteY", "skwAbsoluteX", "adcAbsoluteX", "rorAbsoluteX",
-      "rraAbsoluteX",
-      // 0x80
-      "nopImmediate", "staIndirectX", "nopImmediate", "saxIndirectX",
-      "styZeropage", "staZeropage", "stxZeropage", "saxZeropage", "dey",
-      "nopImmediate", "txa", "xaaImmediate", "styAbsolute", "staAbsolute",
-      "stxAbsolute", "saxAbsolute",
-      // 0x90
-      "bcc", "staIndirectY", "hlt", "shaZeropageY", "styZeropageX",
-      "staZeropageX", "stxZeropageY", "saxZeropageY", "tya", "staAbsoluteY",
-      "txs", "tas", "shy", "staAbsoluteX", "shxAbsoluteY", "shaAbsoluteY",
-      // 0xa0
-      "ldyImmediate", "ldaIndirectX", "ldxImmediate", "laxIndirectX",
-      "ldyZeropage", "ldaZeropage", "ldxZeropage", "laxZeropage", "tay",
-      "ldaImmediate", "tax", "lxaImmediate", "ldyAbsolute", "ldaAbsolute",
-      "ldxAbsolute", "laxAbsolute",
-      // 0xb0
-      "bcs", "ldaIndirectY", "hlt", "laxIndirectY", "ldyZeropageX",
-      "ldaZeropageX", "ldxZeropageY", "laxZeropageY", "clv", "ldaAbsoluteY",
-      "tsx", "lasAbsolute", "ldyAbsoluteX", "ldaAbsoluteX", "ldxAbsoluteY",
-      "laxAbsoluteY",
-      // 0xc0
-      "cpyImmediate", "cmpIndirectX", "nopImmediate", "dcpIndirectX",
-      "cpyZeropage", "cmpZeropage", "decZeropage", "dcpZeropage", "iny",
-      "cmpImmediate", "dex", "sbxImmediate", "cpyAbsolute", "cmpAbsolute",
-      "decAbsolute", "dcpAbsolute",
-      // 0xd0
-      "bne", "cmpIndirectY", "hlt", "dcpIndirectY", "nopZeropageX",
-      "cmpZeropageX", "decZeropageX", "dcpZeropageX", "cld", "cmpAbsoluteY",
-      "nopda", "dcpAbsoluteY", "skwAbsoluteX", "cmpAbsoluteX", "decAbsoluteX",
-      "dcpAbsoluteX",
-      // 0xe0
-      "cpxImmediate", "sbcIndirectX", "nopImmediate", "isbIndirectX",
-      "cpxZeropage", "sbcZeropage", "incZeropage", "isbZeropage", "inx",
-      "sbcImmediate", "nop", "sbcImmediate", "cpxAbsolute", "sbcAbsolute",
-      "incAbsolute", "isbAbsolute",
-      // 0xf0
-      "beq", "sbcIndirectY", "hlt", "isbIndirectY", "nopZeropageX",
-      "sbcZeropageX", "incZeropageX", "isbZeropageX", "sed", "sbcAbsoluteY",
-      "nopfa", "isbAbsoluteY", "skwAbsoluteX", "sbcAbsoluteX", "incAbsoluteX",
-      "isbAbsoluteX"};
-
-  bool cflag;
-  bool zflag;
-  bool dflag;
-  bool bflag;
-  bool vflag;
-  bool nflag;
-  // interrupt flag
-  bool iflag;
-
-  uint8_t a;
-  uint8_t x;
-  uint8_t y;
-  uint8_t sp;
-  uint8_t sr;
-  uint16_t pc;
-
-  void execute(uint8_t idx);
-  void setPCToIntVec(uint16_t intvect, bool intfrombrk);
-  void cmd6502rts();
-
-public:
-  // number of cycles since last adjustment
-  uint8_t numofcycles;
-
-  // stop cpu
-  bool cpuhalted;
-
-  // pure virtual methods
-  virtual void run() = 0;
-  virtual uint8_t getMem(uint16_t addr) = 0;
-  virtual void setMem(uint16_t addr, uint8_t val) = 0;
+#endif
 };
 
 #endif // CPU6502_H
@@ -0,0 +1,2772 @@
+/*
+ Copyright (C) 2024-2026 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef CPU6502IMPL_H
+#define CPU6502IMPL_H
+
+#include "CPU6502.h"
+
+template <typename Bus> void CPU6502<Bus>::modeZeropage() {
+  zl = readMem(pc++);
+  z = zl;
+}
+
+template <typename Bus> void CPU6502<Bus>::modeZeropageX() {
+  zl = readMem(pc++);
+  zl += x;
+  z = zl;
+}
+
+template <typename Bus> void CPU6502<Bus>::modeZeropageY() {
+  zl = readMem(pc++);
+  zl += y;
+  z = zl;
+}
+
+template <typename Bus> void CPU6502<Bus>::modeAbsolute() {
+  zl = readMem(pc++);
+  zh = readMem(pc++);
+  z = (zl + (zh << 8));
+}
+
+template <typename Bus> void CPU6502<Bus>::modeAbsoluteX() {
+  zl = readMem(pc++);
+  zh = readMem(pc++);
+  z = (x + zl + (zh << 8));
+}
+
+template <typename Bus> void CPU6502<Bus>::modeAbsoluteY() {
+  zl = readMem(pc++);
+  zh = readMem(pc++);
+  z = (y + zl + (zh << 8));
+}
+
+template <typename Bus> void CPU6502<Bus>::modeIndirectX() {
+  uint8_t ql = readMem(pc++);
+  ql += x;
+  zl = readMem(ql++);
+  zh = readMem(ql);
+  z = (zl + (zh << 8));
+}
+
+template <typename Bus> void CPU6502<Bus>::modeIndirectY() {
+  uint16_t q = readMem(pc++);
+  zl = readMem(q++);
+  zh = readMem(q);
+  z = (y + (zl | (zh << 8)));
+}
+
+template <typename Bus> void CPU6502<Bus>::setNZ(uint8_t r) {
+  setZ(r);
+  setN(r);
+}
+
+template <typename Bus> void CPU6502<Bus>::atestandsetNZ() { setNZ(a); }
+
+template <typename Bus> void CPU6502<Bus>::xtestandsetNZ() { setNZ(x); }
+
+template <typename Bus> void CPU6502<Bus>::ytestandsetNZ() { setNZ(y); }
+
+template <typename Bus> void CPU6502<Bus>::branchbase(bool flag) {
+  int8_t r = readMem(pc++);
+  if (flag) {
+    uint16_t oldPC = pc;
+    pc += r;
+    numofcycles++;
+    if ((oldPC & 0xFF00) != (pc & 0xFF00)) {
+      numofcycles++;
+    }
+  }
+  numofcycles += 2;
+  if (flag && (r < 0)) {
+    notifyLoopBranch(pc - r - 2);
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::adcbase(uint8_t r) {
+  if (!dflag) {
+    uint16_t a1 = a + r;
+    if (cflag) {
+      a1++;
+    }
+    uint8_t a2 = a1;
+    vflag = (a ^ a2) & (r ^ a2) & 0x80;
+    cflag = a1 >> 8;
+    setNZ(a2);
+    a = a2;
+  } else {
+    uint16_t a2 = a + r;
+    uint8_t al = (a & 0x0F) + (r & 0x0F);
+    if (cflag) {
+      al++;
+      a2++;
+    }
+    setZ(a2);
+    if (al >= 0x0A) {
+      al = ((al + 0x06) & 0x0F) + 0x10;
+    }
+    uint16_t a1 = (a & 0xF0) + (r & 0xF0) + al;
+    vflag = (a ^ a1) & (r ^ a1) & 0x80;
+    setN(a1);
+    cflag = (a1 >= 0xA0);
+    if (a1 >= 0xA0) {
+      a1 += 0x60;
+    }
+    a = a1;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::sbcbase(uint8_t r1) {
+  if (!dflag) {
+    adcbase(~r1);
+  } else {
+    uint8_t r = ~r1;
+    uint16_t a2 = a + r;
+    uint8_t al = (a & 0x0F) + (r & 0x0F);
+    if (cflag) {
+      al++;
+      a2++;
+    }
+    setZ(a2);
+    if (al < 0x10) {
+      al = ((al + 0x0a) & 0x0F);
+    }
+    uint16_t a1 = (a & 0xF0) + (r & 0xF0) + al;
+    vflag = (a ^ a1) & (r ^ a1) & 0x80;
+    setN(a1);
+    cflag = a1 >> 8;
+    if (a1 < 0x100) {
+      a1 += 0xA0;
+    }
+    a = a1;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::incbase() {
+  uint8_t r = readMem(z);
+  r++;
+  writeMem(z, r);
+  setNZ(r);
+}
+
+template <typename Bus> void CPU6502<Bus>::decbase() {
+  uint8_t r = readMem(z);
+  r--;
+  writeMem(z, r);
+  setNZ(r);
+}
+
+template <typename Bus> void CPU6502<Bus>::cmpbase(uint8_t r1, uint8_t r2) {
+  int16_t r = r1 - r2;
+  cflag = true;
+  if (r < 0) {
+    r += 0x100;
+    cflag = false;
+  }
+  setNZ(r);
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::aslbase0(uint8_t r) {
+  uint16_t r1 = r << 1;
+  cflag = false;
+  if (r1 & 0x100) {
+    cflag = true;
+    r1 &= 0xFF;
+  }
+  setNZ(r1);
+  return r1;
+}
+
+template <typename Bus> void CPU6502<Bus>::aslbase() {
+  uint8_t r = readMem(z);
+  r = aslbase0(r);
+  writeMem(z, r);
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::lsrbase0(uint8_t r) {
+  cflag = r & 0x01;
+  r >>= 1;
+  setNZ(r);
+  return r;
+}
+
+template <typename Bus> void CPU6502<Bus>::lsrbase() {
+  uint8_t r = readMem(z);
+  r = lsrbase0(r);
+  writeMem(z, r);
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::rolbase0(uint8_t r) {
+  uint16_t r1 = r << 1;
+  if (cflag) {
+    r1 |= 1;
+  }
+  cflag = false;
+  if (r1 & 0x100) {
+    cflag = true;
+    r1 &= 0xFF;
+  }
+  setNZ(r1);
+  return r1;
+}
+
+template <typename Bus> void CPU6502<Bus>::rolbase() {
+  uint8_t r = readMem(z);
+  r = rolbase0(r);
+  writeMem(z, r);
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::rorbase0(uint8_t r) {
+  uint16_t r1 = r;
+  if (cflag) {
+    r1 |= 0x100;
+  }
+  cflag = r1 & 0x01;
+  r1 >>= 1;
+  setNZ(r1);
+  return r1;
+}
+
+template <typename Bus> void CPU6502<Bus>::rorbase() {
+  uint8_t r = readMem(z);
+  r = rorbase0(r);
+  writeMem(z, r);
+}
+
+template <typename Bus> void CPU6502<Bus>::bitBase() {
+  uint8_t r = readMem(z);
+  setN(r);
+  vflag = r & 64;
+  setZ(r & a);
+}
+
+template <typename Bus> void CPU6502<Bus>::srfromflags() {
+  sr = 32;
+  if (cflag) {
+    sr |= 1;
+  }
+  if (getZFlag()) {
+    sr |= 2;
+  }
+  if (iflag) {
+    sr |= 4;
+  }
+  if (dflag) {
+    sr |= 8;
+  }
+  if (bflag) {
+    sr |= 16;
+  }
+  if (vflag) {
+    sr |= 64;
+  }
+  if (getNFlag()) {
+    sr |= 128;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::flagsfromsr() {
+  cflag = sr & 1;
+  setZ(~sr & 2);
+  iflag = sr & 4;
+  if (!iflag) {
+    notifyIRQEnabled();
+  }
+  dflag = sr & 8;
+  bflag = sr & 16;
+  vflag = sr & 64;
+  setN(sr);
+}
+
+template <typename Bus> void CPU6502<Bus>::pushtostack(uint8_t r) {
+  uint16_t z1 = sp + 0x100;
+  writeMem(z1, r);
+  sp--;
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::pullfromstack() {
+  sp++;
+  uint16_t z1 = sp + 0x100;
+  return readMem(z1);
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502halt() { cpuhalted = true; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502brk() {
+  pc++;
+  setPCToIntVec(readMem(0xfffe) + (readMem(0xffff) << 8), true);
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502aslZeropage() {
+  modeZeropage();
+  aslbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::php() {
+  srfromflags();
+  pushtostack(sr);
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502php() {
+  bflag = true;
+  php();
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraImmediate() {
+  uint8_t r = readMem(pc++);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502aslA() {
+  a = aslbase0(a);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502aslAbsolute() {
+  modeAbsolute();
+  aslbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bpl() {
+  branchbase(!getNFlag());
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502aslZeropageX() {
+  modeZeropageX();
+  aslbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502clc() {
+  cflag = false;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502oraAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502aslAbsoluteX() {
+  modeAbsoluteX();
+  aslbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502jsr() {
+  uint8_t ql = readMem(pc++);
+  // push actual address to 6502 stack
+  uint8_t pcl = pc & 0xFF;
+  uint8_t pch = (pc >> 8);
+  pushtostack(pch);
+  pushtostack(pcl);
+  // set destination address
+  uint8_t qh = readMem(pc);
+  uint16_t q = (ql + (qh << 8));
+  pc = q;
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bitZeropage() {
+  modeZeropage();
+  bitBase();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rolZeropage() {
+  modeZeropage();
+  rolbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::plp() {
+  sr = pullfromstack();
+  flagsfromsr();
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502plp() {
+  plp();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andImmediate() {
+  uint8_t r = readMem(pc++);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ancImmediate() {
+  uint8_t r = readMem(pc++);
+  a &= r;
+  atestandsetNZ();
+  cflag = getNFlag();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rolA() {
+  a = rolbase0(a);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bitAbsolute() {
+  modeAbsolute();
+  bitBase();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rolAbsolute() {
+  modeAbsolute();
+  rolbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bmi() {
+  branchbase(getNFlag());
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rolZeropageX() {
+  modeZeropageX();
+  rolbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sec() {
+  cflag = true;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502andAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rolAbsoluteX() {
+  modeAbsoluteX();
+  rolbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rti() {
+  // get status register from stack
+  plp();
+  // get return address from stack
+  uint8_t pcl = pullfromstack();
+  uint8_t pch = pullfromstack();
+  pc = (pcl + (pch << 8));
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lsrZeropage() {
+  modeZeropage();
+  lsrbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502pha() {
+  pushtostack(a);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorImmediate() {
+  uint8_t r = readMem(pc++);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lsrA() {
+  a = lsrbase0(a);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502jmpAbsolute() {
+  modeAbsolute();
+  uint16_t jmpaddr = pc - 3;
+  pc = z;
+  numofcycles += 3;
+  if (pc <= jmpaddr) {
+    notifyLoopBranch(jmpaddr);
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lsrAbsolute() {
+  modeAbsolute();
+  lsrbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bvc() { branchbase(!vflag); }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lsrZeropageX() {
+  modeZeropageX();
+  lsrbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cli() {
+  iflag = false;
+  notifyIRQEnabled();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502eorAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lsrAbsoluteX() {
+  modeAbsoluteX();
+  lsrbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rts() {
+  uint8_t pcl = pullfromstack();
+  uint8_t pch = pullfromstack();
+  pc = (pcl + 1 + (pch << 8));
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rorZeropage() {
+  modeZeropage();
+  rorbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502pla() {
+  a = pullfromstack();
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcImmediate() {
+  uint8_t r = readMem(pc++);
+  adcbase(r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rorA() {
+  a = rorbase0(a);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502jmpIndirect() {
+  modeAbsolute();
+  uint8_t r1 = readMem(z);
+  zl++;
+  z = (zl + (zh << 8));
+  uint8_t r2 = readMem(z);
+  pc = (r1 + (r2 << 8));
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rorAbsolute() {
+  modeAbsolute();
+  rorbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bvs() { branchbase(vflag); }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rorZeropageX() {
+  modeZeropageX();
+  rorbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sei() {
+  iflag = true;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502adcAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rorAbsoluteX() {
+  modeAbsoluteX();
+  rorbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staIndirectX() {
+  modeIndirectX();
+  writeMem(z, a);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502styZeropage() {
+  modeZeropage();
+  writeMem(z, y);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staZeropage() {
+  modeZeropage();
+  writeMem(z, a);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502stxZeropage() {
+  modeZeropage();
+  writeMem(z, x);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dey() {
+  y--;
+  setNZ(y);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502txa() {
+  a = x;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502styAbsolute() {
+  modeAbsolute();
+  writeMem(z, y);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staAbsolute() {
+  modeAbsolute();
+  writeMem(z, a);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502stxAbsolute() {
+  modeAbsolute();
+  writeMem(z, x);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bcc() { branchbase(!cflag); }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staIndirectY() {
+  modeIndirectY();
+  writeMem(z, a);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502styZeropageX() {
+  modeZeropageX();
+  writeMem(z, y);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staZeropageX() {
+  modeZeropageX();
+  writeMem(z, a);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502stxZeropageY() {
+  modeZeropageY();
+  writeMem(z, x);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502tya() {
+  a = y;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staAbsoluteY() {
+  modeAbsoluteY();
+  writeMem(z, a);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502txs() {
+  sp = x;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502staAbsoluteX() {
+  modeAbsoluteX();
+  writeMem(z, a);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldyImmediate() {
+  y = readMem(pc++);
+  ytestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaIndirectX() {
+  modeIndirectX();
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxIndirectX() {
+  modeIndirectX();
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldxImmediate() {
+  x = readMem(pc++);
+  xtestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldyZeropage() {
+  modeZeropage();
+  y = readMem(z);
+  ytestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaZeropage() {
+  modeZeropage();
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxZeropage() {
+  modeZeropage();
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lxaImmediate() {
+  a = readMem(pc++);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldxZeropage() {
+  modeZeropage();
+  x = readMem(z);
+  xtestandsetNZ();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502tay() {
+  y = a;
+  ytestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaImmediate() {
+  a = readMem(pc++);
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502tax() {
+  x = a;
+  xtestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldyAbsolute() {
+  modeAbsolute();
+  y = readMem(z);
+  ytestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaAbsolute() {
+  modeAbsolute();
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxAbsolute() {
+  modeAbsolute();
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldxAbsolute() {
+  modeAbsolute();
+  x = readMem(z);
+  xtestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bcs() { branchbase(cflag); }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxIndirectY() {
+  modeIndirectY();
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldyZeropageX() {
+  modeZeropageX();
+  y = readMem(z);
+  ytestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaZeropageX() {
+  modeZeropageX();
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxZeropageY() {
+  modeZeropageX();
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldxZeropageY() {
+  modeZeropageY();
+  x = readMem(z);
+  xtestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502clv() {
+  vflag = false;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502laxAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  a = readMem(z);
+  x = a;
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502tsx() {
+  x = sp;
+  xtestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldyAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  y = readMem(z);
+  ytestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldaAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  a = readMem(z);
+  atestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502ldxAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  x = readMem(z);
+  xtestandsetNZ();
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpyImmediate() {
+  uint8_t r = readMem(pc++);
+  cmpbase(y, r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpyZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  cmpbase(y, r);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502decZeropage() {
+  modeZeropage();
+  decbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502iny() {
+  y++;
+  setNZ(y);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpImmediate() {
+  uint8_t r = readMem(pc++);
+  cmpbase(a, r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dex() {
+  x--;
+  setNZ(x);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpyAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  cmpbase(y, r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502decAbsolute() {
+  modeAbsolute();
+  decbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502bne() {
+  branchbase(!getZFlag());
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 5;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502decZeropageX() {
+  modeZeropageX();
+  decbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cld() {
+  dflag = false;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cmpAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502decAbsoluteX() {
+  modeAbsoluteX();
+  decbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpxImmediate() {
+  uint8_t r = readMem(pc++);
+  cmpbase(x, r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcIndirectX() {
+  modeIndirectX();
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpxZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  cmpbase(x, r);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcZeropage() {
+  modeZeropage();
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502incZeropage() {
+  modeZeropage();
+  incbase();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502inx() {
+  x++;
+  setNZ(x);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcImmediate() {
+  uint8_t r = readMem(pc++);
+  sbcbase(r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nop() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502cpxAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  cmpbase(x, r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcAbsolute() {
+  modeAbsolute();
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502incAbsolute() {
+  modeAbsolute();
+  incbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502beq() {
+  branchbase(getZFlag());
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcIndirectY() {
+  uint16_t zold = z;
+  modeIndirectY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 6;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcZeropageX() {
+  modeZeropageX();
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502incZeropageX() {
+  modeZeropageX();
+  incbase();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sed() {
+  dflag = true;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcAbsoluteY() {
+  uint16_t zold = z;
+  modeAbsoluteY();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbcAbsoluteX() {
+  uint16_t zold = z;
+  modeAbsoluteX();
+  bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
+  uint8_t r = readMem(z);
+  sbcbase(r);
+  numofcycles += 4;
+  if (pageCrossed) {
+    numofcycles++;
+  }
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502incAbsoluteX() {
+  modeAbsoluteX();
+  incbase();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nopImmediate() {
+  readMem(pc++);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nopZeropage() {
+  modeZeropage();
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nopZeropageX() {
+  modeZeropageX();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nop1a() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nop3a() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nop5a() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nop7a() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nopda() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502nopfa() { numofcycles += 2; }
+
+template <typename Bus> void CPU6502<Bus>::cmd6502alrImmediate() {
+  uint8_t r = readMem(pc++);
+  a &= r;
+  a = lsrbase0(a);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502saxZeropage() {
+  modeZeropage();
+  writeMem(z, a & x);
+  numofcycles += 3;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502saxZeropageY() {
+  modeZeropageY();
+  writeMem(z, a & x);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502saxAbsolute() {
+  modeAbsolute();
+  writeMem(z, a & x);
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502saxIndirectX() {
+  modeIndirectX();
+  writeMem(z, a & x);
+  numofcycles += 6;
+}
+
+template <typename Bus> uint8_t CPU6502<Bus>::isbincbase() {
+  uint8_t r = readMem(z);
+  r++;
+  writeMem(z, r);
+  return r;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbZeropage() {
+  modeZeropage();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbZeropageX() {
+  modeZeropageX();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbIndirectX() {
+  modeIndirectX();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbIndirectY() {
+  modeIndirectY();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbAbsolute() {
+  modeAbsolute();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbAbsoluteX() {
+  modeAbsoluteX();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502isbAbsoluteY() {
+  modeAbsoluteY();
+  uint8_t r = isbincbase();
+  sbcbase(r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502skwAbsolute() {
+  modeAbsolute();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502skwAbsoluteX() {
+  modeAbsoluteX();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502shaZeropageY() {
+  modeZeropageY();
+  uint8_t r = a & x & zh;
+  writeMem(z, r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502shaAbsoluteY() {
+  modeAbsoluteY();
+  uint8_t r = a & x & zh;
+  writeMem(z, r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502shxAbsoluteY() {
+  modeAbsoluteY();
+  uint8_t r = x & zh;
+  writeMem(z, r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraZeropage() {
+  modeZeropage();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraZeropageX() {
+  modeZeropageX();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraIndirectX() {
+  modeIndirectX();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraIndirectY() {
+  modeIndirectY();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraAbsolute() {
+  modeAbsolute();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraAbsoluteX() {
+  modeAbsoluteX();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rraAbsoluteY() {
+  modeAbsoluteY();
+  rorbase();
+  uint8_t r = readMem(z);
+  adcbase(r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoZeropage() {
+  modeZeropage();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoZeropageX() {
+  modeZeropageX();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoIndirectX() {
+  modeIndirectX();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoIndirectY() {
+  modeIndirectY();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoAbsolute() {
+  modeAbsolute();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoAbsoluteX() {
+  modeAbsoluteX();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502asoAbsoluteY() {
+  modeAbsoluteY();
+  aslbase();
+  uint8_t r = readMem(z);
+  a |= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreZeropage() {
+  modeZeropage();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreZeropageX() {
+  modeZeropageX();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreIndirectX() {
+  modeIndirectX();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreIndirectY() {
+  modeIndirectY();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreAbsolute() {
+  modeAbsolute();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreAbsoluteX() {
+  modeAbsoluteX();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sreAbsoluteY() {
+  modeAbsoluteY();
+  lsrbase();
+  uint8_t r = readMem(z);
+  a ^= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpZeropage() {
+  modeZeropage();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpZeropageX() {
+  modeZeropageX();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpIndirectX() {
+  modeIndirectX();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpIndirectY() {
+  modeIndirectY();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpAbsolute() {
+  modeAbsolute();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpAbsoluteX() {
+  modeAbsoluteX();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502dcpAbsoluteY() {
+  modeAbsoluteY();
+  decbase();
+  uint8_t r = readMem(z);
+  cmpbase(a, r);
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502xaaImmediate() {
+  uint8_t r = readMem(pc++);
+  a = (a | 0xfe) & x & r;
+  atestandsetNZ();
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502sbxImmediate() {
+  uint8_t r = readMem(pc++);
+  x = (a & x) - r;
+  cmpbase(a & x, r);
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502lasAbsolute() {
+  x = sp;
+  a = x;
+  modeAbsoluteY();
+  uint8_t r = readMem(z);
+  a &= r;
+  x = a;
+  sp = x;
+  atestandsetNZ();
+  numofcycles += 4;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaZeropage() {
+  modeZeropage();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaZeropageX() {
+  modeZeropageX();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaIndirectX() {
+  modeIndirectX();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaIndirectY() {
+  modeIndirectY();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 8;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaAbsolute() {
+  modeAbsolute();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 6;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaAbsoluteX() {
+  modeAbsoluteX();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502rlaAbsoluteY() {
+  modeAbsoluteY();
+  rolbase();
+  uint8_t r = readMem(z);
+  a &= r;
+  atestandsetNZ();
+  numofcycles += 7;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502tas() {
+  uint8_t r = a & x;
+  sp = r;
+  modeAbsoluteY();
+  r &= zh + 1;
+  writeMem(z, r);
+  numofcycles += 5;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502arr() {
+  uint8_t r = readMem(pc++);
+  bool oricflag = cflag;
+  a &= r;
+  cflag = a & 128;
+  vflag = ((a & 128) >> 1) ^ (a & 64);
+  uint16_t r1 = a;
+  if (oricflag) {
+    r1 |= 0x100;
+  }
+  r1 >>= 1;
+  setNZ(r1);
+  a = r1;
+  numofcycles += 2;
+}
+
+template <typename Bus> void CPU6502<Bus>::cmd6502shy() {
+  modeAbsoluteX();
+  uint8_t r = y & (zh + 1);
+  writeMem(z, r);
+  numofcycles += 5;
+}
+
+#ifdef USE_CPU_DISPATCH_TABLE
+template <typename Bus>
+void CPU6502<Bus>::execute(uint8_t idx) { (this->*cmdarr6502[idx])(); }
+#else
+template <typename Bus> void CPU6502<Bus>::execute(uint8_t idx) {
+  // dense switch -> jump table, the non virtual opcode methods are inlined
+  switch (idx) {
+  case 0x00:
+    cmd6502brk();
+    break;
+  case 0x01:
+    cmd6502oraIndirectX();
+    break;
+  case 0x02:
+    cmd6502halt();
+    break;
+  case 0x03:
+    cmd6502asoIndirectX();
+    break;
+  case 0x04:
+    cmd6502nopZeropage();
+    break;
+  case 0x05:
+    cmd6502oraZeropage();
+    break;
+  case 0x06:
+    cmd6502aslZeropage();
+    break;
+  case 0x07:
+    cmd6502asoZeropage();
+    break;
+  case 0x08:
+    cmd6502php();
+    break;
+  case 0x09:
+    cmd6502oraImmediate();
+    break;
+  case 0x0a:
+    cmd6502aslA();
+    break;
+  case 0x0b:
+    cmd6502ancImmediate();
+    break;
+  case 0x0c:
+    cmd6502skwAbsolute();
+    break;
+  case 0x0d:
+    cmd6502oraAbsolute();
+    break;
+  case 0x0e:
+    cmd6502aslAbsolute();
+    break;
+  case 0x0f:
+    cmd6502asoAbsolute();
+    break;
+  case 0x10:
+    cmd6502bpl();
+    break;
+  case 0x11:
+    cmd6502oraIndirectY();
+    break;
+  case 0x12:
+    cmd6502halt();
+    break;
+  case 0x13:
+    cmd6502asoIndirectY();
+    break;
+  case 0x14:
+    cmd6502nopZeropageX();
+    break;
+  case 0x15:
+    cmd6502oraZeropageX();
+    break;
+  case 0x16:
+    cmd6502aslZeropageX();
+    break;
+  case 0x17:
+    cmd6502asoZeropageX();
+    break;
+  case 0x18:
+    cmd6502clc();
+    break;
+  case 0x19:
+    cmd6502oraAbsoluteY();
+    break;
+  case 0x1a:
+    cmd6502nop1a();
+    break;
+  case 0x1b:
+    cmd6502asoAbsoluteY();
+    break;
+  case 0x1c:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0x1d:
+    cmd6502oraAbsoluteX();
+    break;
+  case 0x1e:
+    cmd6502aslAbsoluteX();
+    break;
+  case 0x1f:
+    cmd6502asoAbsoluteX();
+    break;
+  case 0x20:
+    cmd6502jsr();
+    break;
+  case 0x21:
+    cmd6502andIndirectX();
+    break;
+  case 0x22:
+    cmd6502halt();
+    break;
+  case 0x23:
+    cmd6502rlaIndirectX();
+    break;
+  case 0x24:
+    cmd6502bitZeropage();
+    break;
+  case 0x25:
+    cmd6502andZeropage();
+    break;
+  case 0x26:
+    cmd6502rolZeropage();
+    break;
+  case 0x27:
+    cmd6502rlaZeropage();
+    break;
+  case 0x28:
+    cmd6502plp();
+    break;
+  case 0x29:
+    cmd6502andImmediate();
+    break;
+  case 0x2a:
+    cmd6502rolA();
+    break;
+  case 0x2b:
+    cmd6502ancImmediate();
+    break;
+  case 0x2c:
+    cmd6502bitAbsolute();
+    break;
+  case 0x2d:
+    cmd6502andAbsolute();
+    break;
+  case 0x2e:
+    cmd6502rolAbsolute();
+    break;
+  case 0x2f:
+    cmd6502rlaAbsolute();
+    break;
+  case 0x30:
+    cmd6502bmi();
+    break;
+  case 0x31:
+    cmd6502andIndirectY();
+    break;
+  case 0x32:
+    cmd6502halt();
+    break;
+  case 0x33:
+    cmd6502rlaIndirectY();
+    break;
+  case 0x34:
+    cmd6502nopZeropageX();
+    break;
+  case 0x35:
+    cmd6502andZeropageX();
+    break;
+  case 0x36:
+    cmd6502rolZeropageX();
+    break;
+  case 0x37:
+    cmd6502rlaZeropageX();
+    break;
+  case 0x38:
+    cmd6502sec();
+    break;
+  case 0x39:
+    cmd6502andAbsoluteY();
+    break;
+  case 0x3a:
+    cmd6502nop3a();
+    break;
+  case 0x3b:
+    cmd6502rlaAbsoluteY();
+    break;
+  case 0x3c:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0x3d:
+    cmd6502andAbsoluteX();
+    break;
+  case 0x3e:
+    cmd6502rolAbsoluteX();
+    break;
+  case 0x3f:
+    cmd6502rlaAbsoluteX();
+    break;
+  case 0x40:
+    cmd6502rti();
+    break;
+  case 0x41:
+    cmd6502eorIndirectX();
+    break;
+  case 0x42:
+    cmd6502halt();
+    break;
+  case 0x43:
+    cmd6502sreIndirectX();
+    break;
+  case 0x44:
+    cmd6502nopZeropage();
+    break;
+  case 0x45:
+    cmd6502eorZeropage();
+    break;
+  case 0x46:
+    cmd6502lsrZeropage();
+    break;
+  case 0x47:
+    cmd6502sreZeropage();
+    break;
+  case 0x48:
+    cmd6502pha();
+    break;
+  case 0x49:
+    cmd6502eorImmediate();
+    break;
+  case 0x4a:
+    cmd6502lsrA();
+    break;
+  case 0x4b:
+    cmd6502alrImmediate();
+    break;
+  case 0x4c:
+    cmd6502jmpAbsolute();
+    break;
+  case 0x4d:
+    cmd6502eorAbsolute();
+    break;
+  case 0x4e:
+    cmd6502lsrAbsolute();
+    break;
+  case 0x4f:
+    cmd6502sreAbsolute();
+    break;
+  case 0x50:
+    cmd6502bvc();
+    break;
+  case 0x51:
+    cmd6502eorIndirectY();
+    break;
+  case 0x52:
+    cmd6502halt();
+    break;
+  case 0x53:
+    cmd6502sreIndirectY();
+    break;
+  case 0x54:
+    cmd6502nopZeropageX();
+    break;
+  case 0x55:
+    cmd6502eorZeropageX();
+    break;
+  case 0x56:
+    cmd6502lsrZeropageX();
+    break;
+  case 0x57:
+    cmd6502sreZeropageX();
+    break;
+  case 0x58:
+    cmd6502cli();
+    break;
+  case 0x59:
+    cmd6502eorAbsoluteY();
+    break;
+  case 0x5a:
+    cmd6502nop5a();
+    break;
+  case 0x5b:
+    cmd6502sreAbsoluteY();
+    break;
+  case 0x5c:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0x5d:
+    cmd6502eorAbsoluteX();
+    break;
+  case 0x5e:
+    cmd6502lsrAbsoluteX();
+    break;
+  case 0x5f:
+    cmd6502sreAbsoluteX();
+    break;
+  case 0x60:
+    cmd6502rts();
+    break;
+  case 0x61:
+    cmd6502adcIndirectX();
+    break;
+  case 0x62:
+    cmd6502halt();
+    break;
+  case 0x63:
+    cmd6502rraIndirectX();
+    break;
+  case 0x64:
+    cmd6502nopZeropage();
+    break;
+  case 0x65:
+    cmd6502adcZeropage();
+    break;
+  case 0x66:
+    cmd6502rorZeropage();
+    break;
+  case 0x67:
+    cmd6502rraZeropage();
+    break;
+  case 0x68:
+    cmd6502pla();
+    break;
+  case 0x69:
+    cmd6502adcImmediate();
+    break;
+  case 0x6a:
+    cmd6502rorA();
+    break;
+  case 0x6b:
+    cmd6502arr();
+    break;
+  case 0x6c:
+    cmd6502jmpIndirect();
+    break;
+  case 0x6d:
+    cmd6502adcAbsolute();
+    break;
+  case 0x6e:
+    cmd6502rorAbsolute();
+    break;
+  case 0x6f:
+    cmd6502rraAbsolute();
+    break;
+  case 0x70:
+    cmd6502bvs();
+    break;
+  case 0x71:
+    cmd6502adcIndirectY();
+    break;
+  case 0x72:
+    cmd6502halt();
+    break;
+  case 0x73:
+    cmd6502rraIndirectY();
+    break;
+  case 0x74:
+    cmd6502nopZeropageX();
+    break;
+  case 0x75:
+    cmd6502adcZeropageX();
+    break;
+  case 0x76:
+    cmd6502rorZeropageX();
+    break;
+  case 0x77:
+    cmd6502rraZeropageX();
+    break;
+  case 0x78:
+    cmd6502sei();
+    break;
+  case 0x79:
+    cmd6502adcAbsoluteY();
+    break;
+  case 0x7a:
+    cmd6502nop7a();
+    break;
+  case 0x7b:
+    cmd6502rraAbsoluteY();
+    break;
+  case 0x7c:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0x7d:
+    cmd6502adcAbsoluteX();
+    break;
+  case 0x7e:
+    cmd6502rorAbsoluteX();
+    break;
+  case 0x7f:
+    cmd6502rraAbsoluteX();
+    break;
+  case 0x80:
+    cmd6502nopImmediate();
+    break;
+  case 0x81:
+    cmd6502staIndirectX();
+    break;
+  case 0x82:
+    cmd6502nopImmediate();
+    break;
+  case 0x83:
+    cmd6502saxIndirectX();
+    break;
+  case 0x84:
+    cmd6502styZeropage();
+    break;
+  case 0x85:
+    cmd6502staZeropage();
+    break;
+  case 0x86:
+    cmd6502stxZeropage();
+    break;
+  case 0x87:
+    cmd6502saxZeropage();
+    break;
+  case 0x88:
+    cmd6502dey();
+    break;
+  case 0x89:
+    cmd6502nopImmediate();
+    break;
+  case 0x8a:
+    cmd6502txa();
+    break;
+  case 0x8b:
+    cmd6502xaaImmediate();
+    break;
+  case 0x8c:
+    cmd6502styAbsolute();
+    break;
+  case 0x8d:
+    cmd6502staAbsolute();
+    break;
+  case 0x8e:
+    cmd6502stxAbsolute();
+    break;
+  case 0x8f:
+    cmd6502saxAbsolute();
+    break;
+  case 0x90:
+    cmd6502bcc();
+    break;
+  case 0x91:
+    cmd6502staIndirectY();
+    break;
+  case 0x92:
+    cmd6502halt();
+    break;
+  case 0x93:
+    cmd6502shaZeropageY();
+    break;
+  case 0x94:
+    cmd6502styZeropageX();
+    break;
+  case 0x95:
+    cmd6502staZeropageX();
+    break;
+  case 0x96:
+    cmd6502stxZeropageY();
+    break;
+  case 0x97:
+    cmd6502saxZeropageY();
+    break;
+  case 0x98:
+    cmd6502tya();
+    break;
+  case 0x99:
+    cmd6502staAbsoluteY();
+    break;
+  case 0x9a:
+    cmd6502txs();
+    break;
+  case 0x9b:
+    cmd6502tas();
+    break;
+  case 0x9c:
+    cmd6502shy();
+    break;
+  case 0x9d:
+    cmd6502staAbsoluteX();
+    break;
+  case 0x9e:
+    cmd6502shxAbsoluteY();
+    break;
+  case 0x9f:
+    cmd6502shaAbsoluteY();
+    break;
+  case 0xa0:
+    cmd6502ldyImmediate();
+    break;
+  case 0xa1:
+    cmd6502ldaIndirectX();
+    break;
+  case 0xa2:
+    cmd6502ldxImmediate();
+    break;
+  case 0xa3:
+    cmd6502laxIndirectX();
+    break;
+  case 0xa4:
+    cmd6502ldyZeropage();
+    break;
+  case 0xa5:
+    cmd6502ldaZeropage();
+    break;
+  case 0xa6:
+    cmd6502ldxZeropage();
+    break;
+  case 0xa7:
+    cmd6502laxZeropage();
+    break;
+  case 0xa8:
+    cmd6502tay();
+    break;
+  case 0xa9:
+    cmd6502ldaImmediate();
+    break;
+  case 0xaa:
+    cmd6502tax();
+    break;
+  case 0xab:
+    cmd6502lxaImmediate();
+    break;
+  case 0xac:
+    cmd6502ldyAbsolute();
+    break;
+  case 0xad:
+    cmd6502ldaAbsolute();
+    break;
+  case 0xae:
+    cmd6502ldxAbsolute();
+    break;
+  case 0xaf:
+    cmd6502laxAbsolute();
+    break;
+  case 0xb0:
+    cmd6502bcs();
+    break;
+  case 0xb1:
+    cmd6502ldaIndirectY();
+    break;
+  case 0xb2:
+    cmd6502halt();
+    break;
+  case 0xb3:
+    cmd6502laxIndirectY();
+    break;
+  case 0xb4:
+    cmd6502ldyZeropageX();
+    break;
+  case 0xb5:
+    cmd6502ldaZeropageX();
+    break;
+  case 0xb6:
+    cmd6502ldxZeropageY();
+    break;
+  case 0xb7:
+    cmd6502laxZeropageY();
+    break;
+  case 0xb8:
+    cmd6502clv();
+    break;
+  case 0xb9:
+    cmd6502ldaAbsoluteY();
+    break;
+  case 0xba:
+    cmd6502tsx();
+    break;
+  case 0xbb:
+    cmd6502lasAbsolute();
+    break;
+  case 0xbc:
+    cmd6502ldyAbsoluteX();
+    break;
+  case 0xbd:
+    cmd6502ldaAbsoluteX();
+    break;
+  case 0xbe:
+    cmd6502ldxAbsoluteY();
+    break;
+  case 0xbf:
+    cmd6502laxAbsoluteY();
+    break;
+  case 0xc0:
+    cmd6502cpyImmediate();
+    break;
+  case 0xc1:
+    cmd6502cmpIndirectX();
+    break;
+  case 0xc2:
+    cmd6502nopImmediate();
+    break;
+  case 0xc3:
+    cmd6502dcpIndirectX();
+    break;
+  case 0xc4:
+    cmd6502cpyZeropage();
+    break;
+  case 0xc5:
+    cmd6502cmpZeropage();
+    break;
+  case 0xc6:
+    cmd6502decZeropage();
+    break;
+  case 0xc7:
+    cmd6502dcpZeropage();
+    break;
+  case 0xc8:
+    cmd6502iny();
+    break;
+  case 0xc9:
+    cmd6502cmpImmediate();
+    break;
+  case 0xca:
+    cmd6502dex();
+    break;
+  case 0xcb:
+    cmd6502sbxImmediate();
+    break;
+  case 0xcc:
+    cmd6502cpyAbsolute();
+    break;
+  case 0xcd:
+    cmd6502cmpAbsolute();
+    break;
+  case 0xce:
+    cmd6502decAbsolute();
+    break;
+  case 0xcf:
+    cmd6502dcpAbsolute();
+    break;
+  case 0xd0:
+    cmd6502bne();
+    break;
+  case 0xd1:
+    cmd6502cmpIndirectY();
+    break;
+  case 0xd2:
+    cmd6502halt();
+    break;
+  case 0xd3:
+    cmd6502dcpIndirectY();
+    break;
+  case 0xd4:
+    cmd6502nopZeropageX();
+    break;
+  case 0xd5:
+    cmd6502cmpZeropageX();
+    break;
+  case 0xd6:
+    cmd6502decZeropageX();
+    break;
+  case 0xd7:
+    cmd6502dcpZeropageX();
+    break;
+  case 0xd8:
+    cmd6502cld();
+    break;
+  case 0xd9:
+    cmd6502cmpAbsoluteY();
+    break;
+  case 0xda:
+    cmd6502nopda();
+    break;
+  case 0xdb:
+    cmd6502dcpAbsoluteY();
+    break;
+  case 0xdc:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0xdd:
+    cmd6502cmpAbsoluteX();
+    break;
+  case 0xde:
+    cmd6502decAbsoluteX();
+    break;
+  case 0xdf:
+    cmd6502dcpAbsoluteX();
+    break;
+  case 0xe0:
+    cmd6502cpxImmediate();
+    break;
+  case 0xe1:
+    cmd6502sbcIndirectX();
+    break;
+  case 0xe2:
+    cmd6502nopImmediate();
+    break;
+  case 0xe3:
+    cmd6502isbIndirectX();
+    break;
+  case 0xe4:
+    cmd6502cpxZeropage();
+    break;
+  case 0xe5:
+    cmd6502sbcZeropage();
+    break;
+  case 0xe6:
+    cmd6502incZeropage();
+    break;
+  case 0xe7:
+    cmd6502isbZeropage();
+    break;
+  case 0xe8:
+    cmd6502inx();
+    break;
+  case 0xe9:
+    cmd6502sbcImmediate();
+    break;
+  case 0xea:
+    cmd6502nop();
+    break;
+  case 0xeb:
+    cmd6502sbcImmediate();
+    break;
+  case 0xec:
+    cmd6502cpxAbsolute();
+    break;
+  case 0xed:
+    cmd6502sbcAbsolute();
+    break;
+  case 0xee:
+    cmd6502incAbsolute();
+    break;
+  case 0xef:
+    cmd6502isbAbsolute();
+    break;
+  case 0xf0:
+    cmd6502beq();
+    break;
+  case 0xf1:
+    cmd6502sbcIndirectY();
+    break;
+  case 0xf2:
+    cmd6502halt();
+    break;
+  case 0xf3:
+    cmd6502isbIndirectY();
+    break;
+  case 0xf4:
+    cmd6502nopZeropageX();
+    break;
+  case 0xf5:
+    cmd6502sbcZeropageX();
+    break;
+  case 0xf6:
+    cmd6502incZeropageX();
+    break;
+  case 0xf7:
+    cmd6502isbZeropageX();
+    break;
+  case 0xf8:
+    cmd6502sed();
+    break;
+  case 0xf9:
+    cmd6502sbcAbsoluteY();
+    break;
+  case 0xfa:
+    cmd6502nopfa();
+    break;
+  case 0xfb:
+    cmd6502isbAbsoluteY();
+    break;
+  case 0xfc:
+    cmd6502skwAbsoluteX();
+    break;
+  case 0xfd:
+    cmd6502sbcAbsoluteX();
+    break;
+  case 0xfe:
+    cmd6502incAbsoluteX();
+    break;
+  case 0xff:
+    cmd6502isbAbsoluteX();
+    break;
+  }
+}
+#endif
+
+template <typename Bus>
+void CPU6502<Bus>::setPCToIntVec(uint16_t intvect, bool intfrombrk) {
+  // push actual address to 6502 stack
+  uint8_t pcl = pc & 0xFF;
+  uint8_t pch = (pc >> 8);
+  pushtostack(pch);
+  pushtostack(pcl);
+  // push state to 6502 stack
+  bflag = intfrombrk;
+  php();
+  // clear d-flag
+  dflag = false;
+  // set interrupt disable flag
+  iflag = true;
+  // set pc
+  pc = intvect;
+  numofcycles += 7;
+}
+
+#endif // CPU6502IMPL_H
@@ -32,7 +32,24 @@
 #define USE_LINUXFS
 #define USE_NOJOYSTICK
 #define USE_NOSOUND
+#define USE_CPU_LAZYFLAGS
+#define USE_VIC_TRIPLEBUFFER
+#define USE_VIC_LINESTREAMING
+#define USE_VIC_RENDERCACHE
+#define USE_VIC_FULLBORDER
 #define LOG_IN_FILE
+#elif defined(LINUX_BENCH)
+#define BOARD_LINUX
+#define USE_NODISPLAY
+#define USE_NO_KEYBOARD
+#define USE_LINUXFS
+#define USE_NOJOYSTICK
+#define USE_NOSOUND
+#define USE_CPU_LAZYFLAGS
+#define USE_VIC_TRIPLEBUFFER
+#define USE_VIC_LINESTREAMING
+#define USE_VIC_RENDERCACHE
+#define USE_VIC_FULLBORDER
 #else
 #define BOARD_LINUX
 #define USE_SDL_DISPLAY
@@ -40,6 +57,12 @@
 #define USE_LINUXFS
 #define USE_SDLJOYSTICK
 #define USE_SDLSOUND
+#define USE_CPU_LAZYFLAGS
+#define USE_VIC_TRIPLEBUFFER
+#define USE_VIC_LINESTREAMING
+#define USE_VIC_RENDERCACHE
+#define USE_VIC_FULLBORDER
+#define USE_VIC_NATIVEPIXELS
 #define WINDOWS_BUSYWAIT
 #endif
 
@@ -54,6 +77,7 @@
 // #define USE_PSRAM
 #define USE_OTA
 #define USE_WIFI_UPLOAD
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_T_DISPLAY_S3)
 #define USE_RM67162
 #define USE_NOFS
@@ -61,11 +85,13 @@
 #define USE_NOSOUND
 #define USE_OTA
 #define USE_WIFI_UPLOAD
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_CYD)
 #define USE_ILI9341
 #define USE_SDCARDCYD
 #define USE_ARDUINOJOYSTICKCYD
 #define USE_CYDSOUND
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_WAVESHARE)
 #define USE_ST7789VSERIAL
 #define USE_SDCARD
@@ -73,6 +99,7 @@
 #define USE_I2SSOUND
 #define USE_OTA
 #define USE_WIFI_UPLOAD
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_LEDMATRIX1)
 #define USE_LEDMATRIXDISPLAY
 #define USE_NOFS
@@ -81,6 +108,7 @@
 #define USE_PSRAM
 #define USE_OTA
 #define USE_WIFI_UPLOAD
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_LEDMATRIX2)
 #define USE_LEDMATRIXDISPLAY
 #define USE_NOFS
@@ -89,6 +117,7 @@
 #define USE_PSRAM
 #define USE_OTA
 #define USE_WIFI_UPLOAD
+#define USE_CPU_LAZYFLAGS
 #elif defined(BOARD_LOLIN_C3_PICO)
 #define USE_NODISPLAY
 #define USE_NOFS
@@ -106,14 +135,59 @@
 // global defines
 #define AUDIO_SAMPLE_RATE 44100
 
+// opcode dispatch of the 6502 cpu: by default execute() uses a switch
+// statement, define USE_CPU_DISPATCH_TABLE to use a table of member function
+// pointers instead
+// #define USE_CPU_DISPATCH_TABLE
+
+// lazy evaluation of the n and z flags of the 6502 cpu (defined for all
+// boards running the emulator)
+// #define USE_CPU_LAZYFLAGS
+
+// triple buffering of the frames drawn by the VIC (avoids tearing, needs two
+// additional frame buffers of 64000 bytes each)
+// #define USE_VIC_TRIPLEBUFFER
+
+// send the rasterlines to the display as soon as they are drawn instead of
+// drawing them into a frame buffer (saves the frame buffer of 64000 bytes,
+// the display driver must support drawing spans of lines); on Linux / Windows
+// line streaming is always compiled in and selected at startup
+// (Config::VICLINESTREAMING)
+// #define USE_VIC_LINESTREAMING
+
+// do not draw a character / bitmap rasterline again if the frame buffer
+// already contains the line drawn from the same data (copy of the data of each
+// line of each frame buffer, about 26 KB per frame buffer, lines with sprites
+// or overlays are always drawn); on Linux / Windows the render cache is always
+// compiled in and selected at startup (Config::VICRENDERCACHE)
+// #define USE_VIC_RENDERCACHE
+
+// record the border color of each visible rasterline (instead of drawing the
+// border with the color at the time of the display refresh, shows raster bars
+// in the border), the display driver must support drawing the border per
+// rasterline; on Linux / Windows the full border is always compiled in and
+// selected at startup (Config::VICFULLBORDER)
+// #define USE_VIC_FULLBORDER
+
+// store two pixels per byte in the frame buffers of the VIC (32000 instead of
+// 64000 bytes per frame buffer, for boards without PSRAM); not supported by
+// the LED matrix display
+// #define USE_VIC_PACKEDBITMAP
+
+// draw the pixels in the format of the display (RGB565 in the byte order of
+// the display controller, XRGB8888 for SDL) instead of C64 color indices, the
+// display driver sends the frame buffer without converting it (frame buffers
+// of 128000 bytes for RGB565 and 256000 bytes for XRGB8888, i.e. 768000 bytes
+// for SDL with USE_VIC_TRIPLEBUFFER); cannot be combined with
+// USE_VIC_PACKEDBITMAP, not supported by the LED matrix and the notcurses
+// display
+// #define USE_VIC_NATIVEPIXELS
+
 #if defined(PLATFORM_LINUX) || defined(_WIN32)
 
 struct Config {
   // --- constants to be defined for each board ---
 
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 20;
-
   // audio
   static const uint8_t DEFAULT_VOLUME = 10;
 
@@ -124,6 +198,17 @@ struct Config {
   static const uint16_t LCDHEIGHT = 284;
   static inline uint16_t LCDSCALE = 3;
 
+  // vic: send the rasterlines to the display as soon as they are drawn
+  // instead of using frame buffers (set at startup)
+  static inline bool VICLINESTREAMING = false;
+
+  // vic: do not draw unchanged character / bitmap rasterlines again (set at
+  // startup)
+  static inline bool VICRENDERCACHE = false;
+
+  // vic: draw the border with the color of each rasterline (set at startup)
+  static inline bool VICFULLBORDER = false;
+
   // filesystem
   static constexpr const char *PATH = "c64prgs/";
   static constexpr const char *CONFIGFILE = ".config.json";
@@ -136,9 +221,6 @@ struct Config {
 struct Config {
   // --- constants to be defined for each board ---
 
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 0;
-
   // no sound
   static const uint8_t DEFAULT_VOLUME = 0;
 
@@ -194,9 +276,6 @@ struct Config {
 struct Config {
   // --- constants to be defined for each board ---
 
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 13;
-
   // no sound
   static const uint8_t DEFAULT_VOLUME = 0;
 
@@ -225,9 +304,6 @@ struct Config {
 struct Config {
   // --- constants to be defined for each board ---
 
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 10;
-
   // --- driver specific constants ---
 
   // filesystem
@@ -259,9 +335,6 @@ struct Config {
 struct Config {
   // --- constants to be defined for each board ---
 
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 11;
-
   // --- driver specific constants ---
 
   // power
@@ -317,9 +390,6 @@ struct Config {
 #elif defined(BOARD_LEDMATRIX1)
 
 struct Config {
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 15;
-
   // filesystem
   static constexpr const char *PATH = "";
   static constexpr const char *CONFIGFILE = ".config.json";
@@ -367,9 +437,6 @@ struct Config {
 #elif defined(BOARD_LEDMATRIX2)
 
 struct Config {
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 15;
-
   // filesystem
   static constexpr const char *PATH = "";
   static constexpr const char *CONFIGFILE = ".config.json";
@@ -420,9 +487,6 @@ struct Config {
 #elif defined(BOARD_LOLIN_C3_PICO)
 
 struct Config {
-  // delay until next display refresh
-  static const uint8_t REFRESHDELAY = 15;
-
   // filesystem
   static constexpr const char *PATH = "";
   static constexpr const char *CONFIGFILE = ".config.json";
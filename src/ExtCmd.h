@@ -317,6 +317,14 @@ enum class ExtCmd {
    * No parameters needed.
    */
   SPECIAL2 = 44,
+
+  /**
+   * @brief Switches to "warp mode" (emulation without throttling, only each
+   * n-th frame is drawn and played) and back.
+   *
+   * No parameters needed.
+   */
+  WARP = 45,
 };
 
 #endif // EXTCMD_H
@@ -608,6 +608,10 @@ uint8_t ExternalCmds::executeNextExternalCmd() {
     PlatformManager::getInstance().log(LOG_INFO, TAG, "execute special2");
     return 0;
   }
+  case ExtCmd::WARP:
+    cpu->warp = !cpu->warp;
+    PlatformManager::getInstance().log(LOG_INFO, TAG, "warp = %x", cpu->warp);
+    return 0;
   case ExtCmd::WAIT: {
     // WAIT is handled before case statement
     return 0;
@@ -15,6 +15,7 @@
  http://www.gnu.org/licenses/.
 */
 #include "Floppy.h"
+#include "CPU6502Impl.h"
 #include "Config.h"
 #include "fs/FileFactory.h"
 #include "platform/PlatformManager.h"
@@ -979,3 +980,6 @@ void Floppy::exeSubroutine(uint16_t regpc) {
 }
 
 void Floppy::run() {}
+
+// explicit instantiation of the cpu core with Floppy as memory bus
+template class CPU6502<Floppy>;
@@ -26,7 +26,7 @@
 #include <string>
 #include <vector>
 
-class Floppy : public CPU6502 {
+class Floppy : public CPU6502<Floppy> {
 private:
   static constexpr uint8_t sectorsPerTrack[41] = {
       0,  21, 21, 21, 21, 21, 21, 21, 21, 21,
@@ -171,8 +171,8 @@ public:
   void rmPrgFromFilename(std::string &filename);
   bool listnextentry(std::string &name, bool start);
 
-  uint8_t getMem(uint16_t addr) override;
-  void setMem(uint16_t addr, uint8_t val) override;
+  uint8_t getMem(uint16_t addr) final;
+  void setMem(uint16_t addr, uint8_t val) final;
   void run() override;
 };
 #endif // FLOPPY_H
@@ -282,6 +282,8 @@ void SID::playAudio() {
   actSampleIdx = 0;
 }
 
+void SID::discardAudio() { actSampleIdx = 0; }
+
 uint8_t SID::getEmuVolume() { return emuVolumeScaled; }
 
 void SID::setEmuVolume(uint8_t volume) {
@@ -85,6 +85,7 @@ public:
   void stopSound(uint8_t voice);
   void fillBuffer(uint16_t rasterline);
   void playAudio();
+  void discardAudio();
   uint8_t getEmuVolume();
   void setEmuVolume(uint8_t volume);
 };
@@ -18,6 +18,7 @@
 #include "Config.h"
 #include "display/DisplayFactory.h"
 #include "platform/PlatformManager.h"
+#include <algorithm>
 #include <cstring>
 #ifdef USE_PSRAM
 #include <esp32-hal-psram.h>
@@ -26,137 +27,282 @@
 
 static const char *TAG = "VIC";
 
-static bool collArr[4] = {false, true, true, true};
-
 VIC::VIC() { bitmap = nullptr; }
 
-void VIC::drawemptyline() {
-  uint8_t colBM = vicreg[0x20] & 15;
-  for (uint16_t i = 0; i < 320; i++) {
-    bitmap[idx++] = colBM;
+#if !defined(USE_VIC_NATIVEPIXELS) && !defined(USE_VIC_PACKEDBITMAP)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "expansion of character / bitmap data requires little endian");
+
+// 4 bits of character / bitmap data expanded to a mask of 4 pixels (0xff:
+// foreground pixel, first pixel in the lowest byte)
+static const uint32_t expandnibble[16] = {
+    0x00000000, 0xff000000, 0x00ff0000, 0xffff0000, 0x0000ff00, 0xff00ff00,
+    0x00ffff00, 0xffffff00, 0x000000ff, 0xff0000ff, 0x00ff00ff, 0xffff00ff,
+    0x0000ffff, 0xff00ffff, 0x00ffffff, 0xffffffff};
+
+// 8 pixels of a byte of standard character / bitmap data
+static inline uint64_t expandStdData(uint8_t data, uint8_t col,
+                                     uint8_t bgcol) {
+  uint64_t mask =
+      expandnibble[data >> 4] | ((uint64_t)expandnibble[data & 0x0f] << 32);
+  uint64_t fg = col * 0x0101010101010101ull;
+  uint64_t bg = bgcol * 0x0101010101010101ull;
+  return bg ^ ((fg ^ bg) & mask);
+}
+
+// 8 pixels of a byte of multicolor character / bitmap data (each bit pair
+// selects a color of tftColArr for 2 pixels)
+static inline uint64_t expandMCData(uint8_t data, const uint8_t *tftColArr) {
+  uint32_t pixels0 = (tftColArr[data >> 6] * 0x00000101u) |
+                     (tftColArr[(data >> 4) & 0x03] * 0x01010000u);
+  uint32_t pixels1 = (tftColArr[(data >> 2) & 0x03] * 0x00000101u) |
+                     (tftColArr[data & 0x03] * 0x01010000u);
+  return pixels0 | ((uint64_t)pixels1 << 32);
+}
+#endif
+
+#ifdef USE_VIC_PACKEDBITMAP
+// 4 bits of character / bitmap data expanded to a mask of 4 pixels of 4 bits
+// (0xf: foreground pixel, first pixel in the lowest bits)
+static const uint16_t expandnibble[16] = {
+    0x0000, 0xf000, 0x0f00, 0xff00, 0x00f0, 0xf0f0, 0x0ff0, 0xfff0,
+    0x000f, 0xf00f, 0x0f0f, 0xff0f, 0x00ff, 0xf0ff, 0x0fff, 0xffff};
+
+// writes 8 pixels of 4 bits (first pixel in the lowest bits) starting at
+// pixel idx, an odd idx keeps the pixels beside the 8 pixels
+static inline void storePackedPixels(uint8_t *bitmap, uint16_t idx,
+                                     uint32_t pixels) {
+  uint8_t *dst = &bitmap[idx >> 1];
+  if (!(idx & 1)) {
+    dst[0] = pixels;
+    dst[1] = pixels >> 8;
+    dst[2] = pixels >> 16;
+    dst[3] = pixels >> 24;
+    return;
   }
+  uint64_t shifted = (uint64_t)pixels << 4;
+  dst[0] = (dst[0] & 0x0f) | (uint8_t)shifted;
+  dst[1] = shifted >> 8;
+  dst[2] = shifted >> 16;
+  dst[3] = shifted >> 24;
+  dst[4] = (dst[4] & 0xf0) | (uint8_t)(shifted >> 32);
+}
+#endif
+
+// sets the pixel idx of the bitmap (see BitmapUtils for the layout)
+void VIC::setPixel(uint16_t idx, uint8_t color) {
+#if defined(USE_VIC_NATIVEPIXELS)
+  ((BitmapUtils::Pixel *)bitmap)[idx] = nativecolors[color & 0x0f];
+#elif defined(USE_VIC_PACKEDBITMAP)
+  uint8_t *dst = &bitmap[idx >> 1];
+  if (idx & 1) {
+    *dst = (*dst & 0x0f) | (color << 4);
+  } else {
+    *dst = (*dst & 0xf0) | (color & 0x0f);
+  }
+#else
+  bitmap[idx] = color;
+#endif
+}
+
+// sets count pixels of the bitmap starting at pixel idx
+void VIC::fillPixels(uint16_t idx, uint16_t count, uint8_t color) {
+#if defined(USE_VIC_NATIVEPIXELS)
+  std::fill_n((BitmapUtils::Pixel *)bitmap + idx, count,
+              nativecolors[color & 0x0f]);
+#elif defined(USE_VIC_PACKEDBITMAP)
+  if ((idx & 1) && (count > 0)) {
+    setPixel(idx++, color);
+    count--;
+  }
+  color &= 0x0f;
+  memset(&bitmap[idx >> 1], color | (color << 4), count >> 1);
+  if (count & 1) {
+    setPixel(idx + count - 1, color);
+  }
+#else
+  memset(&bitmap[idx], color, count);
+#endif
+}
+
+void VIC::drawemptyline() {
+  uint8_t colBM = renderdata->vicreg[0x20] & 15;
+  fillPixels(idx, 320, colBM);
+  idx += 320;
 }
 
 bool VIC::shiftDy(uint8_t bgcol) {
   if ((line < deltay) || (deltay < line - 199)) {
-    bool only38cols = !(vicreg[0x16] & 8);
+    bool only38cols = !(renderdata->vicreg[0x16] & 8);
     if (only38cols) {
-      uint16_t framecol = vicreg[0x20] & 15;
-      for (uint8_t xp = 0; xp < 8; xp++) {
-        bitmap[idx++] = framecol;
-      }
-      for (uint16_t xp = 8; xp < 39 * 8; xp++) {
-        bitmap[idx++] = bgcol;
-      }
-      for (uint8_t xp = 0; xp < 8; xp++) {
-        bitmap[idx++] = framecol;
-      }
+      uint8_t framecol = renderdata->vicreg[0x20] & 15;
+      fillPixels(idx, 8, framecol);
+      fillPixels(idx + 8, 38 * 8, bgcol);
+      fillPixels(idx + 39 * 8, 8, framecol);
     } else {
-      for (uint16_t xp = 0; xp < 40 * 8; xp++) {
-        bitmap[idx++] = bgcol;
-      }
+      fillPixels(idx, 40 * 8, bgcol);
     }
+    idx += 40 * 8;
     return true;
   }
   return false;
 }
 
 void VIC::shiftDx(uint8_t bgcol) {
-  for (uint8_t i = 0; i < deltax; i++) {
-    bitmap[idx++] = bgcol;
-  }
+  fillPixels(idx, deltax, bgcol);
+  idx += deltax;
 }
 
 void VIC::drawOnly38ColsFrame(uint16_t tmpidx) {
-  bool only38cols = !(vicreg[0x16] & 8);
+  bool only38cols = !(renderdata->vicreg[0x16] & 8);
   if (only38cols) {
-    uint8_t framecol = vicreg[0x20] & 15;
-    for (uint8_t xp = 0; xp < 8; xp++) {
-      bitmap[tmpidx++] = framecol;
-    }
+    uint8_t framecol = renderdata->vicreg[0x20] & 15;
+    fillPixels(tmpidx, 8, framecol);
   }
 }
 
-void VIC::drawByteStdData(uint8_t data, uint16_t &idx, uint16_t &xp,
-                          uint8_t col, uint8_t bgcol, uint8_t dx) {
+void VIC::drawByteStdData(uint8_t data, uint16_t &idx, uint8_t col,
+                          uint8_t bgcol, uint8_t dx) {
+#if defined(USE_VIC_NATIVEPIXELS)
+  if (dx == 0) {
+    // write the 8 pixels as 64 bit words
+    uint64_t fg = nativecolors[col & 0x0f] * PIXELREPEAT;
+    uint64_t bg = nativecolors[bgcol & 0x0f] * PIXELREPEAT;
+    uint8_t *dst = bitmap + BitmapUtils::byteIndex(idx);
+    for (uint8_t i = 0; i < 8; i += PIXELSPERWORD) {
+      uint8_t bits =
+          (data >> (8 - PIXELSPERWORD - i)) & ((1 << PIXELSPERWORD) - 1);
+      uint64_t pixels = bg ^ ((fg ^ bg) & nativemasks[bits]);
+      memcpy(dst, &pixels, 8);
+      dst += 8;
+    }
+    idx += 8;
+    return;
+  }
+  // look up the colors once per byte
+  BitmapUtils::Pixel pixels[2] = {nativecolors[bgcol & 0x0f],
+                                  nativecolors[col & 0x0f]};
+  BitmapUtils::Pixel *dst = (BitmapUtils::Pixel *)bitmap + idx;
+  for (uint8_t i = 0; i < 8 - dx; i++) {
+    dst[i] = pixels[(data >> (7 - i)) & 1];
+  }
+  idx += 8 - dx;
+  return;
+#elif defined(USE_VIC_PACKEDBITMAP)
+  if (dx == 0) {
+    // write all 8 pixels at once (also at an odd pixel index)
+    uint32_t mask = expandnibble[data >> 4] |
+                    ((uint32_t)expandnibble[data & 0x0f] << 16);
+    uint32_t fg = (col & 0x0f) * 0x11111111u;
+    uint32_t bg = (bgcol & 0x0f) * 0x11111111u;
+    storePackedPixels(bitmap, idx, bg ^ ((fg ^ bg) & mask));
+    idx += 8;
+    return;
+  }
+#else
+  if (dx == 0) {
+    // write all 8 pixels at once
+    uint64_t pixels = expandStdData(data, col, bgcol);
+    memcpy(&bitmap[idx], &pixels, 8);
+    idx += 8;
+    return;
+  }
+#endif
   uint8_t bitval = 128;
   for (uint8_t i = 0; i < 8 - dx; i++) {
-    if (data & bitval) {
-      bitmap[idx++] = col;
-      spritedatacoll[xp++] = true;
-    } else {
-      bitmap[idx++] = bgcol;
-      xp++;
-    }
+    setPixel(idx++, (data & bitval) ? col : bgcol);
     bitval >>= 1;
   }
 }
 
-void VIC::drawByteMCData(uint8_t data, uint16_t &idx, uint16_t &xp,
-                         uint8_t *tftColArr, bool *collArr, uint8_t dx) {
+void VIC::drawByteMCData(uint8_t data, uint16_t &idx, uint8_t *tftColArr,
+                         uint8_t dx) {
+#if defined(USE_VIC_NATIVEPIXELS)
+  if (dx == 0) {
+    // write the 8 pixels as 64 bit words (each bit pair selects the color of
+    // 2 pixels)
+    const uint64_t PAIRREPEAT = 1 + (1ull << (8 * sizeof(BitmapUtils::Pixel)));
+    uint8_t *dst = bitmap + BitmapUtils::byteIndex(idx);
+    uint8_t bitshift = 6;
+    for (uint8_t i = 0; i < 8; i += PIXELSPERWORD) {
+      uint64_t pixels = 0;
+      for (uint8_t j = 0; j < PIXELSPERWORD; j += 2) {
+        uint8_t tftcolor = tftColArr[(data >> bitshift) & 0x03] & 0x0f;
+        pixels |= (nativecolors[tftcolor] * PAIRREPEAT)
+                  << (j * 8 * sizeof(BitmapUtils::Pixel));
+        bitshift -= 2;
+      }
+      memcpy(dst, &pixels, 8);
+      dst += 8;
+    }
+    idx += 8;
+    return;
+  }
+  BitmapUtils::Pixel *dst = (BitmapUtils::Pixel *)bitmap + idx;
+  for (uint8_t i = 0; i < (8 - dx) >> 1; i++) {
+    BitmapUtils::Pixel pixel =
+        nativecolors[tftColArr[(data >> (6 - 2 * i)) & 0x03] & 0x0f];
+    dst[2 * i] = pixel;
+    dst[2 * i + 1] = pixel;
+  }
+  idx += (8 - dx) & 0xfe;
+  return;
+#elif defined(USE_VIC_PACKEDBITMAP)
+  if (dx == 0) {
+    // each bit pair selects the color of 2 pixels (also at an odd pixel index)
+    uint32_t pixels = ((tftColArr[data >> 6] & 0x0f) * 0x00000011u) |
+                      ((tftColArr[(data >> 4) & 0x03] & 0x0f) * 0x00001100u) |
+                      ((tftColArr[(data >> 2) & 0x03] & 0x0f) * 0x00110000u) |
+                      ((tftColArr[data & 0x03] & 0x0f) * 0x11000000u);
+    storePackedPixels(bitmap, idx, pixels);
+    idx += 8;
+    return;
+  }
+#else
+  if (dx == 0) {
+    // write all 8 pixels at once
+    uint64_t pixels = expandMCData(data, tftColArr);
+    memcpy(&bitmap[idx], &pixels, 8);
+    idx += 8;
+    return;
+  }
+#endif
   uint8_t bitshift = 6;
   for (uint8_t i = 0; i < (8 - dx) >> 1; i++) {
     uint8_t bitpair = (data >> bitshift) & 0x03;
     uint8_t tftcolor = tftColArr[bitpair];
-    bitmap[idx++] = tftcolor;
-    bitmap[idx++] = tftcolor;
-    spritedatacoll[xp++] = collArr[bitpair];
-    spritedatacoll[xp++] = collArr[bitpair];
+    setPixel(idx++, tftcolor);
+    setPixel(idx++, tftcolor);
     bitshift -= 2;
   }
 }
 
 void VIC::drawidleline(uint8_t ghostbyte) {
   uint8_t col = 0;
-  uint8_t bgcol = vicreg[0x20] & 15;
-  uint16_t xp = 0;
+  uint8_t bgcol = renderdata->vicreg[0x20] & 15;
   for (uint16_t i = 0; i < 40; i++) {
-    drawByteStdData(ghostbyte, idx, xp, col, bgcol, 0);
+    drawByteStdData(ghostbyte, idx, col, bgcol, 0);
   }
 }
 
-void VIC::drawStdCharModeInt(uint8_t *screenMap, uint8_t bgcol, uint8_t row,
-                             uint8_t dx, uint16_t &xp, uint16_t yidx,
-                             uint16_t &idx) {
-  uint8_t col = colormap[yidx] & 15;
-  uint8_t ch = screenMap[yidx];
-  uint16_t idxch = ch << 3;
-  uint8_t chardata = charset[idxch + row];
-  drawByteStdData(chardata, idx, xp, col, bgcol, dx);
-}
-
-void VIC::drawStdCharMode(uint8_t *screenMap, uint8_t bgColor) {
+void VIC::drawStdCharMode(uint8_t bgColor) {
   uint8_t bgcol = bgColor & 15;
   if (shiftDy(bgcol)) {
     return;
   }
   shiftDx(bgcol);
-  drawStdCharModeInt(screenMap, bgcol, row, 0, xp, yidx++, idx);
+  const uint8_t *gdata = renderdata->gdata;
+  const uint8_t *coldata = renderdata->coldata;
+  drawByteStdData(gdata[0], idx, coldata[0] & 15, bgcol, 0);
   drawOnly38ColsFrame(idx - 8 - deltax);
   for (uint8_t x = 1; x < 39; x++) {
-    drawStdCharModeInt(screenMap, bgcol, row, 0, xp, yidx++, idx);
+    drawByteStdData(gdata[x], idx, coldata[x] & 15, bgcol, 0);
   }
-  drawStdCharModeInt(screenMap, bgcol, row, deltax, xp, yidx, idx);
+  drawByteStdData(gdata[39], idx, coldata[39] & 15, bgcol, deltax);
   drawOnly38ColsFrame(idx - 8);
 }
 
-void VIC::drawMCCharModeInt(uint8_t *screenMap, uint8_t bgcol,
-                            uint8_t *tftColArr, uint8_t row, uint8_t dx,
-                            uint16_t &xp, uint16_t yidx, uint16_t &idx) {
-  uint8_t colc64 = colormap[yidx] & 15;
-  uint8_t ch = screenMap[yidx];
-  uint16_t idxch = ch << 3;
-  uint8_t chardata = charset[idxch + row];
-  if (colc64 & 8) {
-    tftColArr[3] = colc64 & 7;
-    drawByteMCData(chardata, idx, xp, tftColArr, collArr, dx);
-  } else {
-    drawByteStdData(chardata, idx, xp, colc64, bgcol, dx);
-  }
-}
-
-void VIC::drawMCCharMode(uint8_t *screenMap, uint8_t bgColor, uint8_t color1,
-                         uint8_t color2) {
+void VIC::drawMCCharMode(uint8_t bgColor, uint8_t color1, uint8_t color2) {
   uint8_t bgcol = bgColor & 15;
   if (shiftDy(bgcol)) {
     return;
@@ -166,351 +312,539 @@ void VIC::drawMCCharMode(uint8_t *screenMap, uint8_t bgColor, uint8_t color1,
   tftColArr[0] = bgcol;
   tftColArr[1] = color1 & 15;
   tftColArr[2] = color2 & 15;
-  drawMCCharModeInt(screenMap, bgcol, tftColArr, row, 0, xp, yidx++, idx);
-  drawOnly38ColsFrame(idx - 8 - deltax);
-  for (uint8_t x = 1; x < 39; x++) {
-    drawMCCharModeInt(screenMap, bgcol, tftColArr, row, 0, xp, yidx++, idx);
+  const uint8_t *gdata = renderdata->gdata;
+  const uint8_t *coldata = renderdata->coldata;
+  for (uint8_t x = 0; x < 40; x++) {
+    uint8_t colc64 = coldata[x] & 15;
+    uint8_t dx = (x == 39) ? deltax : 0;
+    if (colc64 & 8) {
+      tftColArr[3] = colc64 & 7;
+      drawByteMCData(gdata[x], idx, tftColArr, dx);
+    } else {
+      drawByteStdData(gdata[x], idx, colc64, bgcol, dx);
+    }
+    if (x == 0) {
+      drawOnly38ColsFrame(idx - 8 - deltax);
+    }
   }
-  drawMCCharModeInt(screenMap, bgcol, tftColArr, row, deltax, xp, yidx, idx);
   drawOnly38ColsFrame(idx - 8);
 }
 
-void VIC::drawExtBGColCharModeInt(uint8_t *screenMap, uint8_t *bgColArr,
-                                  uint8_t row, uint8_t dx, uint16_t &xp,
-                                  uint16_t yidx, uint16_t &idx) {
-  uint8_t col = colormap[yidx] & 15;
-  uint8_t ch = screenMap[yidx];
-  uint8_t ch6bits = ch & 0x3f;
-  uint8_t bgcol = bgColArr[ch >> 6] & 15;
-  uint16_t idxch = ch6bits << 3;
-  uint8_t chardata = charset[idxch + row];
-  drawByteStdData(chardata, idx, xp, col, bgcol, dx);
-}
-
-void VIC::drawExtBGColCharMode(uint8_t *screenMap, uint8_t *bgColArr) {
+void VIC::drawExtBGColCharMode(uint8_t *bgColArr) {
   uint8_t bgcol0 = bgColArr[0];
   if (shiftDy(bgcol0)) {
     return;
   }
   shiftDx(bgcol0);
-  drawExtBGColCharModeInt(screenMap, bgColArr, row, 0, xp, yidx++, idx);
-  drawOnly38ColsFrame(idx - 8 - deltax);
-  for (uint8_t x = 1; x < 39; x++) {
-    drawExtBGColCharModeInt(screenMap, bgColArr, row, 0, xp, yidx++, idx);
+  const uint8_t *cdata = renderdata->cdata;
+  const uint8_t *gdata = renderdata->gdata;
+  const uint8_t *coldata = renderdata->coldata;
+  for (uint8_t x = 0; x < 40; x++) {
+    uint8_t bgcol = bgColArr[cdata[x] >> 6] & 15;
+    uint8_t dx = (x == 39) ? deltax : 0;
+    drawByteStdData(gdata[x], idx, coldata[x] & 15, bgcol, dx);
+    if (x == 0) {
+      drawOnly38ColsFrame(idx - 8 - deltax);
+    }
   }
-  drawExtBGColCharModeInt(screenMap, bgColArr, row, deltax, xp, yidx, idx);
   drawOnly38ColsFrame(idx - 8);
 }
 
-void VIC::drawMCBitmapModeInt(uint8_t *multicolorBitmap, uint8_t *colorMap1,
-                              uint8_t *tftColArr, uint16_t cidx, uint16_t mcidx,
-                              uint8_t row, uint8_t dx, uint16_t &xp,
-                              uint16_t &idx) {
-  uint8_t color1 = colorMap1[cidx];
-  uint8_t color2 = colormap[cidx];
-  tftColArr[1] = (color1 >> 4) & 0x0f;
-  tftColArr[2] = color1 & 0x0f;
-  tftColArr[3] = color2 & 0x0f;
-  uint8_t data = multicolorBitmap[mcidx + row];
-  drawByteMCData(data, idx, xp, tftColArr, collArr, dx);
-}
-
-void VIC::drawMCBitmapMode(uint8_t *multicolorBitmap, uint8_t *colorMap1,
-                           uint8_t backgroundColor) {
+void VIC::drawMCBitmapMode(uint8_t backgroundColor) {
   uint8_t tftColArr[4];
   tftColArr[0] = backgroundColor & 0x0f;
   if (shiftDy(tftColArr[0])) {
     return;
   }
   shiftDx(tftColArr[0]);
-  uint16_t mcidx = (y * 40) << 3;
-  uint16_t xp = 0;
-  drawMCBitmapModeInt(multicolorBitmap, colorMap1, tftColArr, yidx++, mcidx,
-                      row, 0, xp, idx);
-  mcidx += 8;
-  drawOnly38ColsFrame(idx - 8 - deltax);
-  for (uint8_t x = 1; x < 39; x++) {
-    drawMCBitmapModeInt(multicolorBitmap, colorMap1, tftColArr, yidx++, mcidx,
-                        row, 0, xp, idx);
-    mcidx += 8;
+  const uint8_t *cdata = renderdata->cdata;
+  const uint8_t *gdata = renderdata->gdata;
+  const uint8_t *coldata = renderdata->coldata;
+  for (uint8_t x = 0; x < 40; x++) {
+    tftColArr[1] = (cdata[x] >> 4) & 0x0f;
+    tftColArr[2] = cdata[x] & 0x0f;
+    tftColArr[3] = coldata[x] & 0x0f;
+    drawByteMCData(gdata[x], idx, tftColArr, (x == 39) ? deltax : 0);
+    if (x == 0) {
+      drawOnly38ColsFrame(idx - 8 - deltax);
+    }
   }
-  drawMCBitmapModeInt(multicolorBitmap, colorMap1, tftColArr, yidx, mcidx, row,
-                      deltax, xp, idx);
   drawOnly38ColsFrame(idx - 8);
 }
 
-void VIC::drawStdBitmapModeInt(uint8_t *hiresBitmap, uint8_t *colorMap,
-                               uint16_t hiidx, uint16_t &colidx, uint8_t row,
-                               uint8_t dx, uint16_t &xp, uint16_t &idx) {
-  uint8_t color = colorMap[colidx++];
-  uint8_t colorfg = (color & 0xf0) >> 4;
-  uint8_t colorbg = color & 0x0f;
-  uint8_t data = hiresBitmap[hiidx + row];
-  drawByteStdData(data, idx, xp, colorfg, colorbg, dx);
-}
-
-void VIC::drawStdBitmapMode(uint8_t *hiresBitmap, uint8_t *colorMap) {
+void VIC::drawStdBitmapMode() {
   // todo: background color is specific for each "tile"
   if (shiftDy(0)) {
     return;
   }
   shiftDx(0);
-  uint16_t hiidx = (y * 40) << 3;
-  drawStdBitmapModeInt(hiresBitmap, colorMap, hiidx, yidx, row, 0, xp, idx);
-  hiidx += 8;
-  drawOnly38ColsFrame(idx - 8 - deltax);
-  for (uint8_t x = 1; x < 39; x++) {
-    drawStdBitmapModeInt(hiresBitmap, colorMap, hiidx, yidx, row, 0, xp, idx);
-    hiidx += 8;
+  const uint8_t *cdata = renderdata->cdata;
+  const uint8_t *gdata = renderdata->gdata;
+  for (uint8_t x = 0; x < 40; x++) {
+    uint8_t colorfg = (cdata[x] & 0xf0) >> 4;
+    uint8_t colorbg = cdata[x] & 0x0f;
+    drawByteStdData(gdata[x], idx, colorfg, colorbg, (x == 39) ? deltax : 0);
+    if (x == 0) {
+      drawOnly38ColsFrame(idx - 8 - deltax);
+    }
   }
-  drawStdBitmapModeInt(hiresBitmap, colorMap, hiidx, yidx, row, deltax, xp,
-                       idx);
   drawOnly38ColsFrame(idx - 8);
 }
 
-void VIC::drawSpriteDataSC(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                           uint8_t *data, uint8_t color) {
-  uint16_t idx = xpos + ypos * 320;
-  bool only38cols = !(vicreg[0x16] & 8);
-  uint16_t low = only38cols ? 8 : 0;
-  uint16_t high = only38cols ? 312 : 320;
-  for (uint8_t x = 0; x < 3; x++) {
-    uint8_t d = *data++;
-    uint8_t bitval = 128;
-    for (uint8_t i = 0; i < 8; i++) {
-      if (xpos < low) {
-        idx++;
-        xpos++;
-        bitval >>= 1;
-        continue;
-      } else if (xpos >= high) {
-        return;
+// index of the first pixel of a rasterline within the bitmap
+inline uint16_t VIC::lineIndex(uint8_t line) {
+#ifdef USE_VIC_LINESTREAMING
+  if (linestreaming) {
+    return (line % STREAMRINGLINES) * 320;
+  }
+#endif
+  return line * 320;
+}
+
+// 4 bits expanded to 8 bits (each bit doubled, used for X-expanded sprites)
+static const uint8_t doublenibble[16] = {0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33,
+                                         0x3c, 0x3f, 0xc0, 0xc3, 0xcc, 0xcf,
+                                         0xf0, 0xf3, 0xfc, 0xff};
+
+// pixels of a sprite line (24 or 48 pixels, bit 63: first pixel, multicolor:
+// bit pairs != 00)
+static inline uint64_t spritePixelMask(uint32_t data, bool mc, bool ds) {
+  if (mc) {
+    uint32_t t = (data | (data >> 1)) & 0x555555;
+    data = t | (t << 1);
+  }
+  if (!ds) {
+    return (uint64_t)data << 40;
+  }
+  uint64_t pixels = 0;
+  for (int8_t shift = 20; shift >= 0; shift -= 4) {
+    pixels = (pixels << 8) | doublenibble[(data >> shift) & 0x0f];
+  }
+  return pixels << 16;
+}
+
+// do the sprite masks a (starting at word worda) and b overlap?
+static inline bool spriteMasksOverlap(const uint64_t *a, uint8_t worda,
+                                      const uint64_t *b, uint8_t wordb) {
+  if (worda == wordb) {
+    return ((a[0] & b[0]) | (a[1] & b[1])) != 0;
+  } else if (worda + 1 == wordb) {
+    return (a[1] & b[0]) != 0;
+  } else if (wordb + 1 == worda) {
+    return (a[0] & b[1]) != 0;
+  }
+  return false;
+}
+
+template <uint8_t op> void VIC::drawSprites(const RasterlineData &d) {
+  uint8_t spritesdoublex = d.vicreg[0x1d];
+  uint8_t multicolorreg = d.vicreg[0x1c];
+  uint8_t color01 = d.vicreg[0x25] & 0x0f;
+  uint8_t color11 = d.vicreg[0x26] & 0x0f;
+  bool only38cols = !(d.vicreg[0x16] & 8);
+  int16_t low = only38cols ? 8 : 0;
+  int16_t high = only38cols ? 312 : 320;
+  uint16_t lineidx = lineIndex(d.line);
+  // foreground pixels of the character / bitmap data (bit 63 of word 0:
+  // pixel 0)
+  uint64_t datamask[LINEMASKWORDS + 1];
+  if (d.numofsprites > 0) {
+    for (uint8_t w = 0; w < LINEMASKWORDS; w++) {
+      uint64_t m = 0;
+      for (uint8_t i = 0; i < 8; i++) {
+        m = (m << 8) | d.datamask[w * 8 + i];
+      }
+      datamask[w] = m;
+    }
+    datamask[LINEMASKWORDS] = 0;
+  }
+  // visible pixels of the sprites drawn so far (2 words starting at
+  // maskword)
+  uint64_t masks[8][2];
+  uint8_t maskword[8];
+  uint8_t maskbitnr[8];
+  uint8_t numofmasks = 0;
+  for (uint8_t i = 0; i < d.numofsprites; i++) {
+    uint8_t nr = d.spritenr[i];
+    uint8_t bitnr = 1 << nr;
+    int16_t x = d.vicreg[0x00 + nr * 2] - 24;
+    if (d.vicreg[0x10] & bitnr) {
+      x += 256;
+    }
+    bool mc = multicolorreg & bitnr;
+    bool ds = spritesdoublex & bitnr;
+    if ((x >= high) || (x + (ds ? 48 : 24) <= low)) {
+      continue;
+    }
+    const uint8_t *data = d.spritedata[nr];
+    uint32_t data24 = (data[0] << 16) | (data[1] << 8) | data[2];
+    // clip to the visible area and move to the position within the line
+    uint64_t pixels = spritePixelMask(data24, mc, ds);
+    if (x < low) {
+      pixels &= ~0ull >> (low - x);
+    }
+    if (x + 64 > high) {
+      pixels &= ~(~0ull >> (high - x));
+    }
+    int16_t pos = x;
+    if (pos < 0) {
+      pixels <<= -pos;
+      pos = 0;
+    }
+    uint8_t word = pos >> 6;
+    uint8_t shift = pos & 63;
+    uint64_t *mask = masks[numofmasks];
+    mask[0] = pixels >> shift;
+    mask[1] = shift ? pixels << (64 - shift) : 0;
+    if (op & SPRITECOLL) {
+      if (((mask[0] & datamask[word]) | (mask[1] & datamask[word + 1])) != 0) {
+        // sprite - data collision
+        vicreg[0x1f] |= bitnr;
       }
-      if (d & bitval) {
-        uint8_t bgspriteprio = vicreg[0x1b] & bitnr;
-        if (spritedatacoll[xpos]) {
-          // sprite - data collision
-          vicreg[0x1f] |= bitnr;
+      for (uint8_t j = 0; j < numofmasks; j++) {
+        if (spriteMasksOverlap(mask, word, masks[j], maskword[j])) {
+          // sprite - sprite collision
+          vicreg[0x1e] |= bitnr | maskbitnr[j];
         }
-        if (bgspriteprio && spritedatacoll[xpos]) {
-          // background prio
-          idx++;
-        } else {
-          bitmap[idx++] = color;
+      }
+    }
+    if (op & SPRITEDRAW) {
+      uint8_t col = d.vicreg[0x27 + nr] & 0x0f;
+      uint8_t tftcolor[4] = {0, color01, col, color11};
+      bool bgspriteprio = d.vicreg[0x1b] & bitnr;
+      for (uint8_t w = 0; w < 2; w++) {
+        uint64_t m = mask[w];
+        if (bgspriteprio) {
+          m &= ~datamask[word + w];
         }
-        uint8_t sprcoll = spritespritecoll[xpos];
-        if (sprcoll != 0) {
-          // sprite - sprite collision
-          vicreg[0x1e] |= sprcoll | bitnr;
+        while (m != 0) {
+          uint8_t b = __builtin_clzll(m);
+          m &= ~(0x8000000000000000ull >> b);
+          int16_t xpos = (word + w) * 64 + b;
+          if (mc) {
+            uint8_t pair = (xpos - x) >> (ds ? 2 : 1);
+            col = tftcolor[(data24 >> (22 - 2 * pair)) & 0x03];
+          }
+          setPixel(lineidx + xpos, col);
         }
-        spritespritecoll[xpos++] = sprcoll | bitnr;
-      } else {
-        idx++;
-        xpos++;
       }
-      bitval >>= 1;
     }
+    maskword[numofmasks] = word;
+    maskbitnr[numofmasks] = bitnr;
+    numofmasks++;
   }
-}
-
-void VIC::drawSpriteDataSCDS(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                             uint8_t *data, uint8_t color) {
-  uint16_t idx = xpos + ypos * 320;
-  bool only38cols = !(vicreg[0x16] & 8);
-  uint16_t low = only38cols ? 8 : 0;
-  uint16_t high = only38cols ? 312 : 320;
-  for (uint8_t x = 0; x < 3; x++) {
-    uint8_t d = *data++;
-    uint8_t bitval = 128;
-    for (uint8_t i = 0; i < 8; i++) {
-      if (xpos < low) {
-        idx += 2;
-        xpos += 2;
-        bitval >>= 1;
-        continue;
-      } else if (xpos >= high) {
-        return;
+  if (op & SPRITECOLL) {
+    if (vicreg[0x1f] != 0) {
+      if (vicreg[0x1a] & 2) {
+        vicreg[0x19] |= 0x82;
+      } else {
+        vicreg[0x19] |= 0x02;
       }
-      if (d & bitval) {
-        uint8_t bgspriteprio = vicreg[0x1b] & bitnr;
-        if (spritedatacoll[xpos] || spritedatacoll[xpos + 1]) {
-          // sprite - data collision
-          vicreg[0x1f] |= bitnr;
-        }
-        if (bgspriteprio && spritedatacoll[xpos]) {
-          // background prio
-          idx++;
-        } else {
-          bitmap[idx++] = color;
-        }
-        if (bgspriteprio && spritedatacoll[xpos + 1]) {
-          // background prio
-          idx++;
-        } else {
-          bitmap[idx++] = color;
-        }
-        uint8_t sprcoll = spritespritecoll[xpos];
-        if (sprcoll != 0) {
-          // sprite - sprite collision
-          vicreg[0x1e] |= sprcoll | bitnr;
-        }
-        spritespritecoll[xpos++] = sprcoll | bitnr;
+    }
+    if (vicreg[0x1e] != 0) {
+      if (vicreg[0x1a] & 4) {
+        vicreg[0x19] |= 0x84;
       } else {
-        idx += 2;
-        xpos += 2;
+        vicreg[0x19] |= 0x04;
       }
-      bitval >>= 1;
     }
   }
 }
 
-void VIC::drawSpriteDataMC2Bits(uint8_t idxc, uint16_t &idx, int16_t &xpos,
-                                uint8_t bitnr, uint8_t *tftcolor) {
-  bool only38cols = !(vicreg[0x16] & 8);
-  uint16_t low = only38cols ? 8 : 0;
-  uint16_t high = only38cols ? 312 : 320;
-  if (xpos < low) {
-    idx += 2;
-    xpos += 2;
-    return;
-  } else if (xpos >= high) {
+void VIC::fetchRasterline(RasterlineData &d) {
+  uint8_t line = rasterline - 51;
+  d.line = line;
+#ifdef USE_VIC_FULLBORDER
+  d.borderrec = borderrecidx;
+#endif
+  memcpy(d.vicreg, vicreg, sizeof(d.vicreg));
+  if (vertborder) {
+    d.mode = LineMode::EMPTY;
     return;
   }
-  if (idxc) {
-    uint8_t bgspriteprio = vicreg[0x1b] & bitnr;
-    if (spritedatacoll[xpos] || spritedatacoll[xpos + 1]) {
-      // sprite - data collision
-      vicreg[0x1f] |= bitnr;
-    }
-    if (bgspriteprio && spritedatacoll[xpos]) {
-      // background prio
-      idx++;
-    } else {
-      bitmap[idx++] = tftcolor[idxc];
-    }
-    if (bgspriteprio && spritedatacoll[xpos + 1]) {
-      // background prio
-      idx++;
+  uint8_t d011 = vicreg[0x11];
+  uint8_t d016 = vicreg[0x16];
+  int8_t deltay = (d011 & 7) - 3;
+  uint8_t deltax = d016 & 7;
+  bool ecm = d011 & 64;
+  d.deltay = deltay;
+  d.deltax = deltax;
+  if ((caccbadlinecnt > 0) || (deltay < line - 199)) {
+    caccbadlinecnt--;
+    memset(datamask, 0, sizeof(datamask));
+    bool bmm = d011 & 32;
+    bool mcm = d016 & 16;
+    if (bmm) {
+      d.mode = mcm ? LineMode::MCBITMAP : LineMode::STDBITMAP;
+    } else if ((!ecm) && (!mcm)) {
+      d.mode = LineMode::STDCHAR;
+    } else if ((!ecm) && mcm) {
+      d.mode = LineMode::MCCHAR;
+    } else if (ecm && (!mcm)) {
+      d.mode = LineMode::EXTBGCOLCHAR;
     } else {
-      bitmap[idx++] = tftcolor[idxc];
-    }
-    uint8_t bitnrcollxpos0 = spritespritecoll[xpos];
-    uint8_t bitnrcollxpos1 = spritespritecoll[xpos + 1];
-    if (bitnrcollxpos0 != 0) {
-      // sprite - sprite collision
-      vicreg[0x1e] |= bitnrcollxpos0 | bitnr;
+      d.mode = LineMode::INVALID;
     }
-    if (bitnrcollxpos1 != 0) {
-      // sprite - sprite collision
-      vicreg[0x1e] |= bitnrcollxpos1 | bitnr;
+    bool shifted = (line < deltay) || (deltay < line - 199);
+    if ((!shifted) && (d.mode != LineMode::INVALID)) {
+      // fetch video matrix, color ram and character / bitmap data
+      uint8_t y = lineC64map - 1;
+      uint8_t row = ((line & 7) - deltay) & 7;
+      uint16_t yidx = y * 40;
+      memcpy(d.cdata, ram + screenmemstart + yidx, 40);
+      memcpy(d.coldata, colormap + yidx, 40);
+      if (bmm) {
+        uint16_t hiidx = (y * 40) << 3;
+        for (uint8_t x = 0; x < 40; x++) {
+          d.gdata[x] = ram[bitmapstart + hiidx + row];
+          hiidx += 8;
+        }
+      } else {
+        uint8_t chmask = ecm ? 0x3f : 0xff;
+        for (uint8_t x = 0; x < 40; x++) {
+          uint16_t idxch = (d.cdata[x] & chmask) << 3;
+          d.gdata[x] = charset[idxch + row];
+        }
+      }
+      // foreground pixels (multicolor: bit pairs != 00)
+      bool mcbitmap = (d.mode == LineMode::MCBITMAP);
+      bool mcchar = (d.mode == LineMode::MCCHAR);
+      bool mc = false;
+      for (uint8_t x = 0; x < 40; x++) {
+        uint8_t g = d.gdata[x];
+        mc = mcbitmap || (mcchar && (d.coldata[x] & 8));
+        if (mc) {
+          uint8_t t = (g | (g >> 1)) & 0x55;
+          g = t | (t << 1);
+        }
+        datamask[x] = g;
+      }
+      // last byte is only partially visible
+      uint8_t numofbits = mc ? (((8 - deltax) >> 1) << 1) : 8 - deltax;
+      datamask[39] &= (uint8_t)(0xff << (8 - numofbits));
     }
-    spritespritecoll[xpos++] = bitnrcollxpos0 | bitnr;
-    spritespritecoll[xpos++] = bitnrcollxpos1 | bitnr;
   } else {
-    idx += 2;
-    xpos += 2;
-  }
-}
-
-void VIC::drawSpriteDataMC(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                           uint8_t *data, uint8_t color10, uint8_t color01,
-                           uint8_t color11) {
-  uint8_t tftcolor[4] = {0, color01, color10, color11};
-  uint16_t idx = xpos + ypos * 320;
-  for (uint8_t x = 0; x < 3; x++) {
-    uint8_t d = *data++;
-    uint8_t idxc = (d & 192) >> 6;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 48) >> 4;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 12) >> 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 3);
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-  }
-}
-
-void VIC::drawSpriteDataMCDS(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                             uint8_t *data, uint8_t color10, uint8_t color01,
-                             uint8_t color11) {
-  uint8_t tftcolor[4] = {0, color01, color10, color11};
-  uint16_t idx = xpos + ypos * 320;
-  for (uint8_t x = 0; x < 3; x++) {
-    uint8_t d = *data++;
-    uint8_t idxc = (d & 192) >> 6;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    xpos -= 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 48) >> 4;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    xpos -= 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 12) >> 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    xpos -= 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    idxc = (d & 3);
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-    xpos -= 2;
-    drawSpriteDataMC2Bits(idxc, idx, xpos, bitnr, tftcolor);
-  }
-}
-
-void VIC::drawSprites(uint8_t line) {
+    d.mode = LineMode::IDLE;
+    d.ghostbyte = ecm ? ram[vicmem + 0x39ff] : ram[vicmem + 0x3fff];
+    for (uint8_t x = 0; x < 40; x++) {
+      datamask[x] |= d.ghostbyte;
+    }
+  }
+  memcpy(d.datamask, datamask, sizeof(d.datamask));
+  // sprites
+  uint8_t spriteline = rasterline - 1;
   uint8_t spritesenabled = vicreg[0x15];
   uint8_t spritesdoubley = vicreg[0x17];
-  uint8_t spritesdoublex = vicreg[0x1d];
-  uint8_t multicolorreg = vicreg[0x1c];
-  uint8_t color01 = vicreg[0x25] & 0x0f;
-  uint8_t color11 = vicreg[0x26] & 0x0f;
-  memset(spritespritecoll, 0, sizeof(spritespritecoll));
   uint8_t bitval = 128;
+  d.numofsprites = 0;
   for (int8_t nr = 7; nr >= 0; nr--) {
     if (spritesenabled & bitval) {
       uint8_t facysize = (spritesdoubley & bitval) ? 2 : 1;
       uint8_t y = vicreg[0x01 + nr * 2];
-      if ((line >= y) && (line < (y + 21 * facysize))) {
-        int16_t x = vicreg[0x00 + nr * 2] - 24;
-        if (vicreg[0x10] & bitval) {
-          x += 256;
-        }
-        uint8_t ypos = line - 50;
+      if ((spriteline >= y) && (spriteline < (y + 21 * facysize))) {
         uint16_t dataaddr = ram[screenmemstart + 1016 + nr] * 64;
-        uint8_t *data = ram + vicmem + dataaddr + ((line - y) / facysize) * 3;
-        uint8_t col = vicreg[0x27 + nr] & 0x0f;
-        if (multicolorreg & bitval) {
-          if (spritesdoublex & bitval) {
-            drawSpriteDataMCDS(bitval, x, ypos, data, col, color01, color11);
-          } else {
-            drawSpriteDataMC(bitval, x, ypos, data, col, color01, color11);
-          }
-        } else {
-          if (spritesdoublex & bitval) {
-            drawSpriteDataSCDS(bitval, x, ypos, data, col);
-          } else {
-            drawSpriteDataSC(bitval, x, ypos, data, col);
-          }
-        }
+        uint8_t *data =
+            ram + vicmem + dataaddr + ((spriteline - y) / facysize) * 3;
+        d.spritedata[nr][0] = data[0];
+        d.spritedata[nr][1] = data[1];
+        d.spritedata[nr][2] = data[2];
+        d.spritenr[d.numofsprites++] = nr;
       }
     }
     bitval >>= 1;
   }
-  if (vicreg[0x1f] != 0) {
-    if (vicreg[0x1a] & 2) {
-      vicreg[0x19] |= 0x82;
-    } else {
-      vicreg[0x19] |= 0x02;
-    }
+}
+
+// cheap hash (64 bit FNV-1a on 64 bit words) of a rasterline to detect
+// changes against the previous frame (wide enough to make a collision, which
+// would leave a stale line on the display, practically impossible)
+static uint64_t hashRasterline(const uint8_t *src) {
+  uint64_t hash = 14695981039346656037ull;
+  for (uint16_t i = 0; i < BitmapUtils::LINEBYTES; i += 8) {
+    uint64_t data;
+    memcpy(&data, src + i, 8);
+    hash = (hash ^ data) * 1099511628211ull;
   }
-  if (vicreg[0x1e] != 0) {
-    if (vicreg[0x1a] & 4) {
-      vicreg[0x19] |= 0x84;
-    } else {
-      vicreg[0x19] |= 0x04;
+  return hash;
+}
+
+// draws the character / bitmap data of a rasterline (without sprites)
+void VIC::drawLineData(const RasterlineData &d) {
+  // variables for the draw* methods
+  renderdata = &d;
+  line = d.line;
+  idx = lineIndex(line);
+  deltay = d.deltay;
+  deltax = d.deltax;
+  const uint8_t *reg = d.vicreg;
+  switch (d.mode) {
+  case LineMode::EMPTY:
+    drawemptyline();
+    break;
+  case LineMode::IDLE:
+    drawidleline(d.ghostbyte);
+    break;
+  case LineMode::STDCHAR:
+    drawStdCharMode(reg[0x21]);
+    break;
+  case LineMode::MCCHAR:
+    drawMCCharMode(reg[0x21], reg[0x22], reg[0x23]);
+    break;
+  case LineMode::EXTBGCOLCHAR: {
+    uint8_t bgColArr[] = {reg[0x21], reg[0x22], reg[0x23], reg[0x24]};
+    drawExtBGColCharMode(bgColArr);
+    break;
+  }
+  case LineMode::STDBITMAP:
+    drawStdBitmapMode();
+    break;
+  case LineMode::MCBITMAP:
+    drawMCBitmapMode(reg[0x21]);
+    break;
+  case LineMode::INVALID:
+    break;
+  }
+}
+
+#ifdef USE_VIC_RENDERCACHE
+// check if the line of the back buffer was drawn from the same data, else
+// record the data the line is drawn from now
+bool VIC::isLineCached(const RasterlineData &d) {
+  RenderCacheLine &cached = cacheline[d.line];
+  if ((d.mode == LineMode::EMPTY) || (d.mode == LineMode::IDLE) ||
+      (d.mode == LineMode::INVALID) || (d.numofsprites != 0) ||
+      doiactive[0] || doiactive[1]) {
+    cached.valid = false;
+    return false;
+  }
+  RenderCacheLine actual;
+  actual.valid = true;
+  actual.mode = d.mode;
+  actual.deltay = d.deltay;
+  actual.deltax = d.deltax;
+  actual.only38cols = !(d.vicreg[0x16] & 8);
+  memcpy(actual.colors, &d.vicreg[0x20], sizeof(actual.colors));
+  memcpy(actual.cdata, d.cdata, sizeof(actual.cdata));
+  memcpy(actual.coldata, d.coldata, sizeof(actual.coldata));
+  memcpy(actual.gdata, d.gdata, sizeof(actual.gdata));
+  if (memcmp(&actual, &cached, sizeof(RenderCacheLine)) == 0) {
+    return true;
+  }
+  cached = actual;
+  return false;
+}
+#endif
+
+void VIC::renderRasterline(const RasterlineData &d) {
+  uint16_t idxstart = lineIndex(d.line);
+#ifdef USE_VIC_RENDERCACHE
+  if (rendercache) {
+    if (isLineCached(d)) {
+      // the line of the back buffer (and its hash) is still valid
+      line = d.line;
+      drawSprites<SPRITECOLL>(d);
+      if (line == 199) {
+        publishFrame(d);
+      }
+      return;
     }
   }
+#endif
+  drawLineData(d);
+  if (d.mode != LineMode::EMPTY) {
+    drawSprites<SPRITECOLL | SPRITEDRAW>(d);
+    // draw overlay
+    drawOverlay(0);
+    drawOverlay(1);
+  }
+#ifdef USE_VIC_LINESTREAMING
+  if (linestreaming) {
+    streamRasterline(d);
+    return;
+  }
+#endif
+  if (dirtyspans) {
+    linehash[line] = hashRasterline(bitmap + BitmapUtils::byteIndex(idxstart));
+  }
+  // the last visible rasterline completes the frame
+  if (line == 199) {
+    publishFrame(d);
+  }
+}
+
+#ifdef LINUX_BENCH
+int64_t VIC::benchmarkMode(LineMode mode, uint32_t numoflines) {
+  RasterlineData d;
+  d.mode = mode;
+  d.deltay = 0;
+  d.deltax = 0;
+  d.ghostbyte = 0;
+  d.numofsprites = 0;
+  memcpy(d.vicreg, vicreg, sizeof(d.vicreg));
+  memset(d.datamask, 0, sizeof(d.datamask));
+  // pseudo random video matrix, color ram and character / bitmap data
+  uint32_t seed = 1;
+  for (uint8_t x = 0; x < 40; x++) {
+    seed = seed * 1103515245 + 12345;
+    d.cdata[x] = seed >> 24;
+    d.coldata[x] = seed >> 16;
+    d.gdata[x] = seed >> 8;
+  }
+  int64_t start = PlatformManager::getInstance().getTimeUS();
+  for (uint32_t i = 0; i < numoflines; i++) {
+    d.line = i % 200;
+    drawLineData(d);
+  }
+  return PlatformManager::getInstance().getTimeUS() - start;
+}
+#endif
+
+void VIC::publishFrame(const RasterlineData &d) {
+#ifdef USE_VIC_FULLBORDER
+  if (fullborder) {
+    uint16_t bottom = DisplayDriver::BORDERTOPLINES + 200;
+    memcpy(borderlines[backidx], borderrec[d.borderrec], bottom);
+    memcpy(borderlines[backidx] + bottom, borderrec[d.borderrec ^ 1] + bottom,
+           DisplayDriver::BORDERLINES - bottom);
+  }
+#endif
+  frameseq[backidx] = ++actframeseq;
+  frametime[backidx] = PlatformManager::getInstance().getTimeUS();
+  uint8_t oldidx =
+      readyidx.exchange(backidx | FRAMEREADY, std::memory_order_acq_rel);
+  backidx = oldidx & ~FRAMEREADY;
+  bitmap = framebuffers[backidx];
+  linehash = linehashes[backidx];
+#ifdef USE_VIC_RENDERCACHE
+  cacheline = cachelines[backidx];
+#endif
+  // wake up the display loop
+  PlatformManager::getInstance().notifyFrame();
 }
 
+#ifdef USE_VIC_LINESTREAMING
+void VIC::streamRasterline(const RasterlineData &d) {
+  if ((d.line % STREAMCHUNKLINES) != (STREAMCHUNKLINES - 1)) {
+    return;
+  }
+  // the chunk of lines is complete, send it to the display (the next chunk
+  // is drawn into the other half of the ring)
+  uint8_t firstline = d.line + 1 - STREAMCHUNKLINES;
+  PlatformManager::getInstance().lock();
+  if (firstline == 0) {
+    display->drawFrame(d.vicreg[0x20] & 15);
+  }
+  const uint8_t *lines = bitmap + BitmapUtils::byteIndex(lineIndex(firstline));
+  display->drawBitmapLines(lines, d.vicreg, firstline, STREAMCHUNKLINES);
+  PlatformManager::getInstance().unlock();
+  cntLinesSent.fetch_add(STREAMCHUNKLINES, std::memory_order_release);
+  if (d.line == 199) {
+    // wake up the display loop
+    PlatformManager::getInstance().notifyFrame();
+  }
+}
+#endif
+
 void VIC::initVarsAndRegs() {
   for (uint8_t i = 0; i < 0x40; i++) {
     vicreg[i] = 0;
@@ -522,12 +856,18 @@ void VIC::initVarsAndRegs() {
   vicreg[0x1a] = 0xf0;
 
   cntRefreshs.store(0, std::memory_order_release);
+  cntFramesDropped.store(0, std::memory_order_release);
+  cntFramesDuplicated.store(0, std::memory_order_release);
+  sumFrameLatencyUS.store(0, std::memory_order_release);
+  cntLinesSent.store(0, std::memory_order_release);
   vicmem = 0;
   bitmapstart = 0x2000;
   screenmemstart = 1024;
   rasterline = 0;
   charset = chrom;
   vertborder = true;
+  memset(datamask, 0, sizeof(datamask));
+  drawframe = true;
   doiactive[0] = false;
   doiactive[1] = false;
 }
@@ -540,24 +880,131 @@ void VIC::init(uint8_t *ram, const uint8_t *charrom) {
   this->ram = ram;
   this->chrom = charrom;
 
-  // allocate bitmap memory to be transfered to LCD
-#ifdef USE_PSRAM
-  if (psramFound()) {
-    PlatformManager::getInstance().log(LOG_INFO, TAG, "use PSRAM for bitmap");
-    bitmap = (uint8_t *)ps_malloc(320 * 200);
-  } else {
-    PlatformManager::getInstance().log(LOG_WARN, TAG,
-                                       "no PSRAM available, allocate SRAM");
-    bitmap = new uint8_t[320 * 200];
-  }
-#else
-  bitmap = new uint8_t[320 * 200];
-#endif
-
   // init display
   PlatformManager::getInstance().log(LOG_INFO, TAG, "init display");
   display = Display::create();
   display->init();
+#ifdef USE_VIC_NATIVEPIXELS
+  for (uint8_t i = 0; i < 16; i++) {
+    nativecolors[i] = display->getNativeColor(i);
+  }
+  for (uint8_t bits = 0; bits < (1 << PIXELSPERWORD); bits++) {
+    nativemasks[bits] = 0;
+    for (uint8_t i = 0; i < PIXELSPERWORD; i++) {
+      if (bits & (1 << (PIXELSPERWORD - 1 - i))) {
+        nativemasks[bits] |= (uint64_t)(BitmapUtils::Pixel)~0
+                             << (i * 8 * sizeof(BitmapUtils::Pixel));
+      }
+    }
+  }
+#endif
+#ifdef USE_VIC_LINESTREAMING
+#if defined(PLATFORM_LINUX) || defined(_WIN32)
+  linestreaming = Config::VICLINESTREAMING && display->supportsBitmapLines();
+#else
+  linestreaming = display->supportsBitmapLines();
+#endif
+  dirtyspans = !linestreaming && display->supportsBitmapLines();
+#else
+  dirtyspans = display->supportsBitmapLines();
+#endif
+  sentlinesvalid = false;
+#ifdef USE_VIC_FULLBORDER
+#if defined(PLATFORM_LINUX) || defined(_WIN32)
+  fullborder = Config::VICFULLBORDER && display->supportsBorderLines();
+#else
+  fullborder = display->supportsBorderLines();
+#endif
+#ifdef USE_VIC_LINESTREAMING
+  fullborder = fullborder && !linestreaming;
+#endif
+  borderrecidx = 0;
+  memset(borderrec, 0, sizeof(borderrec));
+#endif
+#ifdef USE_VIC_RENDERCACHE
+#if defined(PLATFORM_LINUX) || defined(_WIN32)
+  rendercache = Config::VICRENDERCACHE;
+#else
+  rendercache = true;
+#endif
+#ifdef USE_VIC_LINESTREAMING
+  rendercache = rendercache && !linestreaming;
+#endif
+#endif
+
+  // allocate bitmap memory to be transfered to LCD
+#ifdef USE_VIC_TRIPLEBUFFER
+  uint8_t numofframebuffers = 3;
+#else
+  uint8_t numofframebuffers = 1;
+#endif
+#ifdef USE_VIC_LINESTREAMING
+  if (linestreaming) {
+    PlatformManager::getInstance().log(LOG_INFO, TAG, "use line streaming");
+    numofframebuffers = 1;
+  }
+#endif
+  for (uint8_t i = 0; i < numofframebuffers; i++) {
+#ifdef USE_VIC_LINESTREAMING
+    if (linestreaming) {
+      // ring of line buffers instead of a frame buffer
+      framebuffers[i] =
+          new uint8_t[BitmapUtils::LINEBYTES * STREAMRINGLINES]();
+      linehashes[i] = nullptr;
+#ifdef USE_VIC_RENDERCACHE
+      cachelines[i] = nullptr;
+#endif
+#ifdef USE_VIC_FULLBORDER
+      borderlines[i] = nullptr;
+#endif
+      continue;
+    }
+#endif
+#ifdef USE_PSRAM
+    if (psramFound()) {
+      PlatformManager::getInstance().log(LOG_INFO, TAG, "use PSRAM for bitmap");
+      framebuffers[i] = (uint8_t *)ps_malloc(BitmapUtils::BITMAPBYTES);
+    } else {
+      PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                         "no PSRAM available, allocate SRAM");
+      framebuffers[i] = new uint8_t[BitmapUtils::BITMAPBYTES]();
+    }
+#else
+    framebuffers[i] = new uint8_t[BitmapUtils::BITMAPBYTES]();
+#endif
+    linehashes[i] = dirtyspans ? new uint64_t[200]() : nullptr;
+#ifdef USE_VIC_RENDERCACHE
+    cachelines[i] = rendercache ? new RenderCacheLine[200]() : nullptr;
+#endif
+#ifdef USE_VIC_FULLBORDER
+    borderlines[i] =
+        fullborder ? new uint8_t[DisplayDriver::BORDERLINES]() : nullptr;
+#endif
+  }
+  for (uint8_t i = numofframebuffers; i < 3; i++) {
+    framebuffers[i] = framebuffers[0];
+    linehashes[i] = linehashes[0];
+#ifdef USE_VIC_RENDERCACHE
+    cachelines[i] = cachelines[0];
+#endif
+#ifdef USE_VIC_FULLBORDER
+    borderlines[i] = borderlines[0];
+#endif
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    frameseq[i] = 0;
+    frametime[i] = 0;
+  }
+  actframeseq = 0;
+  lastframeseq = 0;
+  frontidx = 0;
+  readyidx.store(1, std::memory_order_release);
+  backidx = 2;
+  bitmap = framebuffers[backidx];
+  linehash = linehashes[backidx];
+#ifdef USE_VIC_RENDERCACHE
+  cacheline = cachelines[backidx];
+#endif
 
   // div init
   colormap = new uint8_t[1024]();
@@ -566,11 +1013,76 @@ void VIC::init(uint8_t *ram, const uint8_t *charrom) {
 
 void VIC::refresh() {
   dispOverlayInfo();
-  display->drawBitmap(bitmap, vicreg);
+#ifdef USE_VIC_LINESTREAMING
+  if (linestreaming) {
+    // the rasterlines are sent to the display while they are drawn
+    cntRefreshs.fetch_add(1, std::memory_order_release);
+    return;
+  }
+#endif
+  // take the newest completed frame (if any)
+  bool newframe = readyidx.load(std::memory_order_acquire) & FRAMEREADY;
+  if (newframe) {
+    frontidx =
+        readyidx.exchange(frontidx, std::memory_order_acq_rel) & ~FRAMEREADY;
+    uint32_t seq = frameseq[frontidx];
+    if (seq - lastframeseq > 1) {
+      cntFramesDropped.fetch_add(seq - lastframeseq - 1,
+                                 std::memory_order_release);
+    }
+    lastframeseq = seq;
+  } else {
+    cntFramesDuplicated.fetch_add(1, std::memory_order_release);
+  }
+#ifdef USE_VIC_FULLBORDER
+  if (fullborder) {
+    // the border is drawn together with the bitmap
+    display->drawBorderLines(borderlines[frontidx]);
+  }
+#endif
+  if (dirtyspans) {
+    drawDirtyLines(framebuffers[frontidx], linehashes[frontidx]);
+  } else {
+    display->drawBitmap(framebuffers[frontidx], vicreg);
+  }
+#ifdef USE_VIC_FULLBORDER
+  if (!fullborder) {
+    display->drawFrame(vicreg[0x20] & 15);
+  }
+#else
   display->drawFrame(vicreg[0x20] & 15);
+#endif
+  if (newframe) {
+    int64_t latency =
+        PlatformManager::getInstance().getTimeUS() - frametime[frontidx];
+    sumFrameLatencyUS.fetch_add(latency, std::memory_order_release);
+  }
   cntRefreshs.fetch_add(1, std::memory_order_release);
 }
 
+void VIC::drawDirtyLines(const uint8_t *frame, const uint64_t *hash) {
+  // send runs of lines which differ from the lines shown on the display (the
+  // first refresh sends the whole frame)
+  uint16_t numoflinessent = 0;
+  uint8_t y = 0;
+  while (y < 200) {
+    if (sentlinesvalid && (hash[y] == sentlinehash[y])) {
+      y++;
+      continue;
+    }
+    uint8_t firstline = y;
+    while ((y < 200) && (!sentlinesvalid || (hash[y] != sentlinehash[y]))) {
+      sentlinehash[y] = hash[y];
+      y++;
+    }
+    display->drawBitmapLines(frame + firstline * BitmapUtils::LINEBYTES, vicreg,
+                             firstline, y - firstline);
+    numoflinessent += y - firstline;
+  }
+  sentlinesvalid = true;
+  cntLinesSent.fetch_add(numoflinessent, std::memory_order_release);
+}
+
 void VIC::drawOverlay(uint8_t doiidx) {
   if (!doiactive[doiidx]) {
     return;
@@ -583,7 +1095,7 @@ void VIC::drawOverlay(uint8_t doiidx) {
   uint8_t crow = doistartx[doiidx];
   uint8_t bgcol = doibgcol[doiidx] & 15;
   uint8_t fgcol = doicol[doiidx] & 15;
-  uint16_t idxdoi = line * 320 + crow * 8;
+  uint16_t idxdoi = lineIndex(line) + crow * 8;
   uint16_t tidxdoi = crow + cline * 40;
   uint8_t rowdoi = line & 7;
   for (uint8_t x = 0; x < doiw[doiidx]; x++) {
@@ -593,9 +1105,9 @@ void VIC::drawOverlay(uint8_t doiidx) {
     uint8_t bitval = 128;
     for (uint8_t i = 0; i < 8; i++) {
       if (data & bitval) {
-        bitmap[idxdoi++] = fgcol;
+        setPixel(idxdoi++, fgcol);
       } else {
-        bitmap[idxdoi++] = bgcol;
+        setPixel(idxdoi++, bgcol);
       }
       bitval >>= 1;
     }
@@ -660,54 +1172,22 @@ uint8_t VIC::nextRasterline() {
 }
 
 void VIC::drawRasterline() {
+#ifdef USE_VIC_FULLBORDER
+  // record the border color of the rasterline (only for drawn frames)
+  if (fullborder && drawframe &&
+      ((uint16_t)(rasterline - FIRSTBORDERLINE) < DisplayDriver::BORDERLINES)) {
+    if (rasterline == FIRSTBORDERLINE) {
+      borderrecidx ^= 1;
+    }
+    borderrec[borderrecidx][rasterline - FIRSTBORDERLINE] = vicreg[0x20] & 15;
+  }
+#endif
   if ((rasterline >= 51) && (rasterline < 251)) {
-    line = rasterline - 51;
-    idx = line * 320;
-    if (!vertborder) {
-      uint8_t d011 = vicreg[0x11];
-      deltay = (d011 & 7) - 3;
-      bool ecm = d011 & 64;
-      if ((caccbadlinecnt > 0) || (deltay < line - 199)) {
-        caccbadlinecnt--;
-        memset(spritedatacoll, false, sizeof(bool) * sizeof(spritedatacoll));
-        uint8_t d016 = vicreg[0x16];
-        deltax = d016 & 7;
-        bool bmm = d011 & 32;
-        bool mcm = d016 & 16;
-        // variables for the draw* methods
-        y = lineC64map - 1;
-        row = ((line & 7) - deltay) & 7;
-        yidx = y * 40;
-        xp = 0;
-        if (bmm) {
-          if (mcm) {
-            drawMCBitmapMode(ram + bitmapstart, ram + screenmemstart,
-                             vicreg[0x21]);
-          } else {
-            drawStdBitmapMode(ram + bitmapstart, ram + screenmemstart);
-          }
-        } else {
-          if ((!ecm) && (!mcm)) {
-            drawStdCharMode(ram + screenmemstart, vicreg[0x21]);
-          } else if ((!ecm) && mcm) {
-            drawMCCharMode(ram + screenmemstart, vicreg[0x21], vicreg[0x22],
-                           vicreg[0x23]);
-          } else if (ecm && (!mcm)) {
-            uint8_t bgColArr[] = {vicreg[0x21], vicreg[0x22], vicreg[0x23],
-                                  vicreg[0x24]};
-            drawExtBGColCharMode(ram + screenmemstart, bgColArr);
-          }
-        }
-      } else {
-        uint8_t ghostbyte = ecm ? ram[vicmem + 0x39ff] : ram[vicmem + 0x3fff];
-        drawidleline(ghostbyte);
-      }
-      drawSprites(rasterline - 1);
-      // draw overlay
-      drawOverlay(0);
-      drawOverlay(1);
-    } else {
-      drawemptyline();
+    fetchRasterline(fetchdata);
+    if (drawframe) {
+      renderRasterline(fetchdata);
+    } else if (fetchdata.mode != LineMode::EMPTY) {
+      drawSprites<SPRITECOLL>(fetchdata);
     }
   }
 }
@@ -17,21 +17,149 @@
 #ifndef VIC_H
 #define VIC_H
 
+#include "Config.h"
+#include "display/BitmapUtils.h"
 #include "display/DisplayDriver.h"
 #include <atomic>
 #include <cstdint>
 
+// kind of a rasterline within the bitmap
+enum class LineMode : uint8_t {
+  EMPTY,
+  IDLE,
+  STDCHAR,
+  MCCHAR,
+  EXTBGCOLCHAR,
+  STDBITMAP,
+  MCBITMAP,
+  INVALID
+};
+
+// data of a rasterline fetched by the VIC: registers, video matrix, color
+// ram, character / bitmap data and sprite data. The rasterline is drawn
+// using only this data.
+struct RasterlineData {
+  LineMode mode;
+  uint8_t line;
+  int8_t deltay;
+  uint8_t deltax;
+  uint8_t ghostbyte;
+#ifdef USE_VIC_FULLBORDER
+  // record of the border colors of the frame (see VIC::borderrec)
+  uint8_t borderrec;
+#endif
+  // sprites visible in this rasterline in drawing order (sprite 7 first)
+  uint8_t numofsprites;
+  uint8_t spritenr[8];
+  uint8_t vicreg[0x2f];
+  uint8_t cdata[40];
+  uint8_t coldata[40];
+  uint8_t gdata[40];
+  uint8_t spritedata[8][3];
+  // foreground pixels (1 bit per pixel, used for sprite - data collisions and
+  // sprite priority)
+  uint8_t datamask[41];
+};
+
+#ifdef USE_VIC_RENDERCACHE
+// data a character / bitmap rasterline without sprites is drawn from (the
+// render cache compares it byte by byte)
+struct RenderCacheLine {
+  bool valid;
+  LineMode mode;
+  int8_t deltay;
+  uint8_t deltax;
+  uint8_t only38cols;
+  uint8_t colors[5];
+  uint8_t cdata[40];
+  uint8_t coldata[40];
+  uint8_t gdata[40];
+};
+#endif
+
 class VIC {
 private:
+  // operations of the sprite methods: detect collisions, draw pixels
+  static const uint8_t SPRITECOLL = 1;
+  static const uint8_t SPRITEDRAW = 2;
+  // sprites and collisions use bit masks of the pixels of a rasterline
+  // (64 pixels per word)
+  static const uint8_t LINEMASKWORDS = 5;
+
   uint8_t *ram;
+  // frame buffer the actual frame is drawn into (the back buffer, see
+  // BitmapUtils for the layout)
   uint8_t *bitmap;
-  uint8_t spritespritecoll[320];
-  bool spritedatacoll[320];
-  uint8_t startbyte;
+  uint8_t datamask[41];
   bool vertborder;
   uint8_t lineC64map;
   bool denbadline;
   uint8_t caccbadlinecnt;
+  RasterlineData fetchdata;
+
+  // triple buffering: a completed frame is published by exchanging the back
+  // buffer with the ready buffer, refresh() exchanges the ready buffer with
+  // the front buffer if it contains a newer frame (without triple buffering
+  // all three indices refer to the same frame buffer)
+  static const uint8_t FRAMEREADY = 0x80;
+  uint8_t *framebuffers[3];
+  uint32_t frameseq[3];
+  int64_t frametime[3];
+  uint32_t actframeseq;
+  uint32_t lastframeseq;
+  uint8_t backidx;
+  uint8_t frontidx;
+  std::atomic<uint8_t> readyidx;
+
+  // partial display updates: a 64 bit hash per line of each frame buffer is
+  // compared against the hash of the line last sent to the display, only runs
+  // of changed lines are sent (if supported by the display driver)
+  bool dirtyspans;
+  uint64_t *linehashes[3];
+  uint64_t *linehash;
+  uint64_t sentlinehash[200];
+  bool sentlinesvalid;
+
+#ifdef USE_VIC_LINESTREAMING
+  // line streaming: the rasterlines are drawn into a small ring of line
+  // buffers instead of a frame buffer, each chunk of lines is sent to the
+  // display as soon as its last line is drawn
+  static const uint8_t STREAMCHUNKLINES = 8;
+  static const uint8_t STREAMRINGLINES = 2 * STREAMCHUNKLINES;
+  bool linestreaming;
+#endif
+
+#ifdef USE_VIC_RENDERCACHE
+  // render cache: data each line of each frame buffer was drawn from, a line
+  // drawn from the same data is not drawn again
+  bool rendercache;
+  RenderCacheLine *cachelines[3];
+  RenderCacheLine *cacheline;
+#endif
+
+#ifdef USE_VIC_FULLBORDER
+  // full border: the emulation task records the border color of each visible
+  // rasterline (starting at FIRSTBORDERLINE) of each drawn frame, alternating
+  // between two records; a completed frame gets the top border and the lines
+  // beside the bitmap from its own record and the bottom border (not yet
+  // emulated) from the record of the last drawn frame
+  static const uint8_t FIRSTBORDERLINE = 16;
+  bool fullborder;
+  uint8_t borderrec[2][DisplayDriver::BORDERLINES];
+  uint8_t borderrecidx;
+  uint8_t *borderlines[3];
+#endif
+
+#ifdef USE_VIC_NATIVEPIXELS
+  // C64 colors in the pixel format of the display
+  BitmapUtils::Pixel nativecolors[16];
+  // pixels written as one 64 bit word, a pixel repeated in all of them and
+  // the masks of the foreground pixels for each combination of their bits of
+  // character / bitmap data (first pixel in the lowest bits)
+  static const uint8_t PIXELSPERWORD = 8 / sizeof(BitmapUtils::Pixel);
+  static const uint64_t PIXELREPEAT = ~0ull / (BitmapUtils::Pixel)~0;
+  uint64_t nativemasks[1 << PIXELSPERWORD];
+#endif
 
   // doi
   uint8_t doitextmap[1000];
@@ -44,70 +172,47 @@ private:
   uint8_t doiw[2];
   uint8_t doih[2];
 
-  // members to reduce repetition of code
+  // members to reduce repetition of code (used by the draw* methods)
+  const RasterlineData *renderdata;
   uint8_t line;
   uint16_t idx;
-  uint8_t y;
-  uint8_t row;
-  uint16_t yidx;
   uint16_t xp;
   int8_t deltay;
   uint8_t deltax;
 
-  inline void drawByteStdData(uint8_t data, uint16_t &idx, uint16_t &xp,
-                              uint8_t col, uint8_t bgcol, uint8_t dx)
+  inline void setPixel(uint16_t idx, uint8_t color)
+      __attribute__((always_inline));
+  inline void fillPixels(uint16_t idx, uint16_t count, uint8_t color)
       __attribute__((always_inline));
-  inline void drawByteMCData(uint8_t data, uint16_t &idx, uint16_t &xp,
-                             uint8_t *tftColArr, bool *collArr, uint8_t dx)
+  inline void drawByteStdData(uint8_t data, uint16_t &idx, uint8_t col,
+                              uint8_t bgcol, uint8_t dx)
       __attribute__((always_inline));
+  inline void drawByteMCData(uint8_t data, uint16_t &idx, uint8_t *tftColArr,
+                             uint8_t dx) __attribute__((always_inline));
   void drawemptyline();
   void drawidleline(uint8_t ghostbyte);
   inline bool shiftDy(uint8_t bgcol) __attribute__((always_inline));
   inline void shiftDx(uint8_t bgcol) __attribute__((always_inline));
   inline void drawOnly38ColsFrame(uint16_t tmpidx)
       __attribute__((always_inline));
-  inline void drawStdCharModeInt(uint8_t *screenMap, uint8_t bgcol, uint8_t row,
-                                 uint8_t dx, uint16_t &xp, uint16_t idxmap,
-                                 uint16_t &idx) __attribute__((always_inline));
-  void drawStdCharMode(uint8_t *screenMap, uint8_t bgColor);
-  inline void drawExtBGColCharModeInt(uint8_t *screenMap, uint8_t *bgColArr,
-                                      uint8_t row, uint8_t dx, uint16_t &xp,
-                                      uint16_t idxmap, uint16_t &idx)
-      __attribute__((always_inline));
-  void drawExtBGColCharMode(uint8_t *screenMap, uint8_t *bgColArr);
-  inline void drawMCCharModeInt(uint8_t *screenMap, uint8_t bgcol,
-                                uint8_t *tftColArr, uint8_t row, uint8_t dx,
-                                uint16_t &xp, uint16_t idxmap, uint16_t &idx)
-      __attribute__((always_inline));
-  void drawMCCharMode(uint8_t *screenMap, uint8_t bgColor1, uint8_t bgColor2,
-                      uint8_t bgColor3);
-  inline void drawMCBitmapModeInt(uint8_t *multicolorBitmap, uint8_t *colorMap1,
-                                  uint8_t *tftColArr, uint16_t cidx,
-                                  uint16_t mcidx, uint8_t row, uint8_t dx,
-                                  uint16_t &xp, uint16_t &idx)
-      __attribute__((always_inline));
-  void drawMCBitmapMode(uint8_t *multicolorBitmap, uint8_t *colorMap1,
-                        uint8_t backgroundColor);
-  inline void drawStdBitmapModeInt(uint8_t *hiresBitmap, uint8_t *colorMap,
-                                   uint16_t hiidx, uint16_t &colidx,
-                                   uint8_t row, uint8_t dx, uint16_t &xp,
-                                   uint16_t &idx)
-      __attribute__((always_inline));
-  void drawStdBitmapMode(uint8_t *hiresBitmap, uint8_t *colorMap);
-  void drawSpriteDataSC(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                        uint8_t *data, uint8_t color);
-  void drawSpriteDataSCDS(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                          uint8_t *data, uint8_t color);
-  inline void drawSpriteDataMC2Bits(uint8_t idxc, uint16_t &idx, int16_t &xpos,
-                                    uint8_t bitnr, uint8_t *tftcolor)
-      __attribute__((always_inline));
-  void drawSpriteDataMC(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                        uint8_t *data, uint8_t color10, uint8_t color01,
-                        uint8_t color11);
-  void drawSpriteDataMCDS(uint8_t bitnr, int16_t xpos, uint8_t ypos,
-                          uint8_t *data, uint8_t color10, uint8_t color01,
-                          uint8_t color11);
-  void drawSprites(uint8_t line);
+  void drawStdCharMode(uint8_t bgColor);
+  void drawExtBGColCharMode(uint8_t *bgColArr);
+  void drawMCCharMode(uint8_t bgColor1, uint8_t bgColor2, uint8_t bgColor3);
+  void drawMCBitmapMode(uint8_t backgroundColor);
+  void drawStdBitmapMode();
+  template <uint8_t op> void drawSprites(const RasterlineData &d);
+  void fetchRasterline(RasterlineData &d);
+  void drawLineData(const RasterlineData &d);
+#ifdef USE_VIC_RENDERCACHE
+  bool isLineCached(const RasterlineData &d);
+#endif
+  void renderRasterline(const RasterlineData &d);
+  void publishFrame(const RasterlineData &d);
+#ifdef USE_VIC_LINESTREAMING
+  void streamRasterline(const RasterlineData &d);
+#endif
+  inline uint16_t lineIndex(uint8_t line) __attribute__((always_inline));
+  void drawDirtyLines(const uint8_t *frame, const uint64_t *hash);
   inline void checkFrameColor() __attribute__((always_inline));
   void dispOverlayInfoInt(uint8_t doiidx);
   void dispOverlayInfo();
@@ -119,6 +224,11 @@ public:
 
   // profiling info
   std::atomic<uint8_t> cntRefreshs;
+  std::atomic<uint16_t> cntFramesDropped;
+  std::atomic<uint16_t> cntFramesDuplicated;
+  // sum of the times from completing a frame to having sent it to the display
+  std::atomic<uint32_t> sumFrameLatencyUS;
+  std::atomic<uint32_t> cntLinesSent;
 
   uint8_t *colormap;
   const uint8_t *charset;
@@ -134,6 +244,10 @@ public:
 
   bool doiactive[2];
 
+  // draw the actual frame (if false, the rasterlines are only fetched to
+  // detect sprite collisions)
+  bool drawframe;
+
   VIC();
   void initVarsAndRegs();
   void init(uint8_t *ram, const uint8_t *charrom);
@@ -143,5 +257,10 @@ public:
   void drawDOIBox(uint8_t *box, uint8_t x, uint8_t y, uint8_t w, uint8_t h,
                   uint8_t fgcol, uint8_t bgcol, uint16_t duration,
                   uint8_t doiidx);
+#ifdef LINUX_BENCH
+  // micro-benchmark of the draw methods: draws numoflines rasterlines of the
+  // given mode (pseudo random data, no sprites), returns the time in us
+  int64_t benchmarkMode(LineMode mode, uint32_t numoflines);
+#endif
 };
 #endif // VIC_H
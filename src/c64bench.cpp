@@ -0,0 +1,283 @@
+/*
+ Copyright (C) 2024-2026 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#if defined(PLATFORM_LINUX) && defined(LINUX_BENCH)
+#include "C64Emu.h"
+#include "ExtCmdQueue.h"
+#include "display/NoDisplay.h"
+#include "platform/PlatformManager.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// headless benchmark: no display, no audio device, no throttling
+//
+// usage: c64bench [-frames n] [-boot n] [-warp] [-display] [-linestreaming]
+//                 [-rendercache] [-fullborder] [-vicmodes]
+//                 [-maskcias | file.prg | file.d64]
+//
+// The file is searched in Config::PATH. After booting the kernal for "boot"
+// frames (not measured), a prg file is started using the AUTOSTART command, a
+// d64 file is attached and LOAD"*",8,1 is typed in. Then "frames" frames are
+// emulated and measured. With -warp only each n-th frame is drawn (warp mode),
+// with -display a separate task refreshes the (not existing) display whenever
+// the VIC has completed a frame and the number of bytes which would be sent to
+// the display is reported, with -linestreaming the rasterlines are sent to the
+// display as soon as they are drawn (no frame buffer), with -rendercache
+// unchanged character / bitmap rasterlines are not drawn again, with
+// -fullborder the border color of each rasterline is recorded. With -vicmodes
+// only the draw methods of the VIC are measured for each character and bitmap
+// mode (no emulation). With -maskcias a built-in program masking all CIA
+// interrupts (as most games and demos running on raster interrupts do) is
+// measured.
+
+static const char *TAG = "c64bench";
+
+static const uint32_t PALFRAMESPERSECOND = 50;
+
+// the cycle counters of C64Sys are 32 bit wide (at most 63 cycles per
+// rasterline, 312 rasterlines per frame)
+static const uint32_t MAXFRAMES = UINT32_MAX / (63 * 312);
+
+// program started by -maskcias: masks all CIA interrupts, then copies a page
+// of the screen once per frame and waits for rasterline $80 (idle loop
+// reading $d012)
+static const uint16_t MASKCIASADDR = 0xc000;
+static const uint8_t maskciasprg[] = {
+    0x78,             // sei
+    0xa9, 0x7f,       // lda #$7f
+    0x8d, 0x0d, 0xdc, // sta $dc0d
+    0x8d, 0x0d, 0xdd, // sta $dd0d
+    0xad, 0x0d, 0xdc, // lda $dc0d
+    0xad, 0x0d, 0xdd, // lda $dd0d
+    0xa2, 0x00,       // loop: ldx #$00
+    0xbd, 0x00, 0x04, // copy: lda $0400,x
+    0x9d, 0x00, 0xc4, // sta $c400,x
+    0xe8,             // inx
+    0xd0, 0xf7,       // bne copy
+    0xad, 0x12, 0xd0, // wait: lda $d012
+    0xc9, 0x80,       // cmp #$80
+    0xd0, 0xf9,       // bne wait
+    0xad, 0x12, 0xd0, // wait2: lda $d012
+    0xc9, 0x80,       // cmp #$80
+    0xf0, 0xf9,       // beq wait2
+    0x4c, 0x0f, 0xc0  // jmp loop
+};
+
+C64Emu c64Emu;
+
+static std::atomic<uint32_t> numofrefreshs{0};
+
+static void displayTask(void *parameter) {
+  while (true) {
+    if (PlatformManager::getInstance().waitForFrame(100)) {
+      c64Emu.cpu.vic.refresh();
+      numofrefreshs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+static void benchmarkVICModes(VIC &vic, uint32_t numofframes) {
+  static const struct {
+    LineMode mode;
+    const char *name;
+  } modes[] = {{LineMode::STDCHAR, "standard character"},
+               {LineMode::MCCHAR, "multicolor character"},
+               {LineMode::EXTBGCOLCHAR, "extended background color"},
+               {LineMode::STDBITMAP, "standard bitmap"},
+               {LineMode::MCBITMAP, "multicolor bitmap"}};
+  uint32_t numoflines = numofframes * 200;
+  for (const auto &m : modes) {
+    int64_t us = vic.benchmarkMode(m.mode, numoflines);
+    std::printf("vic %s mode: %.1f ns/line\n", m.name,
+                1000.0 * us / numoflines);
+  }
+}
+
+static bool endsWith(const std::string &str, const std::string &suffix) {
+  return (str.size() > suffix.size()) &&
+         (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+int main(int argc, char *argv[]) {
+  // parse arguments
+  uint32_t numofframes = 3000;
+  uint32_t numofbootframes = 150;
+  std::string filename;
+  bool warp = false;
+  bool display = false;
+  bool vicmodes = false;
+  bool maskcias = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if ((arg == "-frames") && (i + 1 < argc)) {
+      numofframes = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "-boot") && (i + 1 < argc)) {
+      numofbootframes = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-warp") {
+      warp = true;
+    } else if (arg == "-display") {
+      display = true;
+    } else if (arg == "-linestreaming") {
+      Config::VICLINESTREAMING = true;
+    } else if (arg == "-rendercache") {
+      Config::VICRENDERCACHE = true;
+    } else if (arg == "-fullborder") {
+      Config::VICFULLBORDER = true;
+    } else if (arg == "-vicmodes") {
+      vicmodes = true;
+    } else if (arg == "-maskcias") {
+      maskcias = true;
+    } else {
+      filename = arg;
+    }
+  }
+  if ((numofframes == 0) || (numofbootframes == 0)) {
+    std::fprintf(stderr, "number of frames must be greater than 0\n");
+    return EXIT_FAILURE;
+  }
+  if (numofframes > MAXFRAMES) {
+    std::fprintf(stderr, "number of frames must be at most %u\n", MAXFRAMES);
+    return EXIT_FAILURE;
+  }
+  bool isd64 = endsWith(filename, ".d64");
+  bool isprg = endsWith(filename, ".prg");
+  if (!filename.empty() && ((!isd64 && !isprg) || maskcias)) {
+    std::fprintf(stderr,
+                 "usage: %s [-frames n] [-boot n] [-warp] [-display] "
+                 "[-linestreaming] [-rendercache] [-fullborder] [-vicmodes] "
+                 "[-maskcias | file.prg | file.d64]\n",
+                 argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // init emulator (no cpu task, no timers)
+  try {
+    c64Emu.initSystem();
+  } catch (...) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG, "initSystem() failed");
+    return EXIT_FAILURE;
+  }
+  C64Sys &cpu = c64Emu.cpu;
+  cpu.throttle = false;
+  if (vicmodes) {
+    benchmarkVICModes(cpu.vic, numofframes);
+    return EXIT_SUCCESS;
+  }
+
+  ExtCmdQueue::ExternalCmd extCmd;
+  if (warp) {
+    extCmd.cmd = ExtCmd::WARP;
+    ExtCmdQueue::getInstance().push(extCmd);
+  }
+  std::string name = filename.substr(0, filename.size() - 4);
+  if (isd64) {
+    extCmd.cmd = ExtCmd::ATTACHD64;
+    size_t copied = name.copy((char *)&extCmd.param[2], 250);
+    extCmd.param[2 + copied] = '\0';
+    ExtCmdQueue::getInstance().push(extCmd);
+  }
+
+  // boot
+  cpu.numofframestorun = numofbootframes;
+  cpu.run();
+  if (cpu.cpuhalted) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG, "cpu halted");
+    return EXIT_FAILURE;
+  }
+
+  // start program
+  if (isprg) {
+    extCmd.cmd = ExtCmd::AUTOSTART;
+    size_t copied = name.copy((char *)&extCmd.param[2], 250);
+    extCmd.param[2 + copied] = '\0';
+    ExtCmdQueue::getInstance().push(extCmd);
+  } else if (isd64) {
+    // LOAD"*",8,1 (abbreviated to fit into the 10 byte keyboard buffer)
+    static const uint8_t loadcmd[] = {'L', 0xcf, '"', '*', '"',
+                                      ',', '8',  ',', '1', 0x0d};
+    for (uint8_t i = 0; i < sizeof(loadcmd); i++) {
+      cpu.setMem(0x0277 + i, loadcmd[i]);
+    }
+    cpu.setMem(0x00c6, sizeof(loadcmd));
+  } else if (maskcias) {
+    for (uint8_t i = 0; i < sizeof(maskciasprg); i++) {
+      cpu.setMem(MASKCIASADDR + i, maskciasprg[i]);
+    }
+    cpu.setPC(MASKCIASADDR);
+  }
+
+  // measure
+  NoDisplay *nodisplay = static_cast<NoDisplay *>(cpu.vic.display);
+  if (display) {
+    PlatformManager::getInstance().startTask(displayTask, 0, 1);
+  }
+  nodisplay->numofbytessent.store(0, std::memory_order_relaxed);
+  cpu.numofcyclespersecond.store(0, std::memory_order_release);
+  cpu.numofidlecyclespersecond.store(0, std::memory_order_release);
+  cpu.numofcopyfillcyclespersecond.store(0, std::memory_order_release);
+  cpu.numofframestorun = numofframes;
+  int64_t start = PlatformManager::getInstance().getTimeUS();
+  cpu.run();
+  int64_t end = PlatformManager::getInstance().getTimeUS();
+  if (cpu.cpuhalted) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG, "cpu halted");
+    return EXIT_FAILURE;
+  }
+  if (!cpu.checkEventScheduling()) {
+    PlatformManager::getInstance().log(
+        LOG_ERROR, TAG, "next event scheduled before the actual cycle");
+    return EXIT_FAILURE;
+  }
+  uint32_t numofcycles =
+      cpu.numofcyclespersecond.load(std::memory_order_acquire);
+  uint32_t numofidlecycles =
+      cpu.numofidlecyclespersecond.load(std::memory_order_acquire);
+  uint32_t numofcopyfillcycles =
+      cpu.numofcopyfillcyclespersecond.load(std::memory_order_acquire);
+  uint32_t refreshs = numofrefreshs.load(std::memory_order_relaxed);
+  uint64_t bytessent =
+      nodisplay->numofbytessent.load(std::memory_order_relaxed);
+  double seconds = (end - start) / 1000000.0;
+  double framespersecond = numofframes / seconds;
+  std::printf("file: %s\n", maskcias           ? "(masked CIAs)"
+                            : filename.empty() ? "-"
+                                               : filename.c_str());
+  std::printf("vic: linestreaming %s, rendercache %s, fullborder %s\n",
+              Config::VICLINESTREAMING ? "on" : "off",
+              Config::VICRENDERCACHE ? "on" : "off",
+              Config::VICFULLBORDER ? "on" : "off");
+  std::printf("warp: %s\n", cpu.warp ? "on" : "off");
+  std::printf("frames: %u, cycles: %u (idle loops: %u, copy/fill loops: %u), "
+              "time: %.3f s\n",
+              numofframes, numofcycles, numofidlecycles, numofcopyfillcycles,
+              seconds);
+  std::printf("cycles/s: %.0f, frames/s: %.1f, speed: %.2fx PAL\n",
+              numofcycles / seconds, framespersecond,
+              framespersecond / PALFRAMESPERSECOND);
+  if (display || Config::VICLINESTREAMING) {
+    // bytes sent to a RGB565 display compared to sending each emulated frame
+    uint64_t fullbytes = (uint64_t)numofframes * 320 * 200 * 2;
+    std::printf("display: refreshs: %u, bytes sent: %llu (%.1f%% of all "
+                "frames)\n",
+                refreshs, (unsigned long long)bytessent,
+                100.0 * bytessent / fullbytes);
+  }
+  return EXIT_SUCCESS;
+}
+#endif
@@ -1,5 +1,6 @@
-#if defined(PLATFORM_LINUX) || defined(_WIN32)
+#if (defined(PLATFORM_LINUX) || defined(_WIN32)) && !defined(LINUX_BENCH)
 #include "C64Emu.h"
+#include "ExtCmdQueue.h"
 #include "platform/PlatformManager.h"
 
 static const char *TAG = "c64linux";
@@ -8,6 +9,7 @@ C64Emu c64Emu;
 
 int main(int argc, char *argv[]) {
   // parse arguments
+  bool warp = false;
   for (int i = 1; i < argc; i++) {
     if (std::string(argv[i]) == "-scale" && i + 1 < argc) {
       int val = std::atoi(argv[i + 1]);
@@ -15,6 +17,12 @@ int main(int argc, char *argv[]) {
         Config::LCDSCALE = val;
       }
       i++;
+    } else if (std::string(argv[i]) == "-rendercache") {
+      Config::VICRENDERCACHE = true;
+    } else if (std::string(argv[i]) == "-fullborder") {
+      Config::VICFULLBORDER = true;
+    } else if (std::string(argv[i]) == "-warp") {
+      warp = true;
     }
   }
 
@@ -25,6 +33,11 @@ int main(int argc, char *argv[]) {
     PlatformManager::getInstance().log(LOG_ERROR, TAG, "setup() failed");
     return EXIT_FAILURE;
   }
+  if (warp) {
+    ExtCmdQueue::ExternalCmd extCmd;
+    extCmd.cmd = ExtCmd::WARP;
+    ExtCmdQueue::getInstance().push(extCmd);
+  }
   PlatformManager::getInstance().log(LOG_INFO, TAG, "starting emulator");
   while (true) {
     c64Emu.loop();
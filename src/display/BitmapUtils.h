@@ -17,10 +17,49 @@
 #ifndef BITMAP_UTILS_H
 #define BITMAP_UTILS_H
 
+#include "../Config.h"
 #include <cstdint>
 
+#if defined(USE_VIC_PACKEDBITMAP) && defined(USE_VIC_NATIVEPIXELS)
+#error "packed bitmap and native pixels cannot be combined"
+#endif
+
 class BitmapUtils {
 public:
+  // layout of the bitmap drawn by the VIC: one C64 color per byte, in packed
+  // mode two C64 colors per byte (low nibble: left pixel), with native pixels
+  // one pixel in the format of the display (XRGB8888 for SDL, RGB565 in the
+  // byte order of the display controller otherwise)
+#if defined(USE_VIC_NATIVEPIXELS) && defined(USE_SDL_DISPLAY)
+  typedef uint32_t Pixel;
+#elif defined(USE_VIC_NATIVEPIXELS)
+  typedef uint16_t Pixel;
+#else
+  typedef uint8_t Pixel;
+#endif
+#ifdef USE_VIC_PACKEDBITMAP
+  static const uint8_t PIXELSPERBYTE = 2;
+#else
+  static const uint8_t PIXELSPERBYTE = 1;
+#endif
+  static const uint16_t LINEBYTES = 320 * sizeof(Pixel) / PIXELSPERBYTE;
+  static const uint32_t BITMAPBYTES = 200 * LINEBYTES;
+
+  // byte offset of a pixel within the bitmap
+  static constexpr uint32_t byteIndex(uint32_t pixelidx) {
+    return pixelidx * sizeof(Pixel) / PIXELSPERBYTE;
+  }
+
+  // C64 color of a pixel of the bitmap
+  static inline uint8_t getPixel(const uint8_t *bitmap, uint32_t pixelidx) {
+#ifdef USE_VIC_PACKEDBITMAP
+    uint8_t data = bitmap[pixelidx >> 1];
+    return (pixelidx & 1) ? (data >> 4) : (data & 0x0f);
+#else
+    return bitmap[pixelidx] & 0x0f;
+#endif
+  }
+
   static inline void getBitmap(const uint8_t *__restrict__ src,
                                uint16_t *__restrict__ dst,
                                const uint16_t *__restrict__ colors,
@@ -39,6 +78,71 @@ public:
       *dst++ = colors[*src++ & 0x0f];
     }
   }
+
+  // fills the lookup table mapping a byte of a packed bitmap to its two
+  // pixels (the left pixel in the lower half, i.e. at the lower address on
+  // little endian cpus)
+  static void initPackedColors(const uint16_t *colors, uint32_t *packedcolors) {
+    for (uint16_t i = 0; i < 256; i++) {
+      packedcolors[i] = colors[i & 0x0f] | ((uint32_t)colors[i >> 4] << 16);
+    }
+  }
+
+  // converts count pixels (even) of a packed bitmap, dst must be 4 byte
+  // aligned
+  static inline void getBitmapPacked(const uint8_t *__restrict__ src,
+                                     uint16_t *__restrict__ dst,
+                                     const uint32_t *__restrict__ packedcolors,
+                                     uint16_t count) {
+    uint32_t *dst32 = (uint32_t *)dst;
+    count >>= 1;
+    // loop-unrolling
+    while (count >= 4) {
+      dst32[0] = packedcolors[src[0]];
+      dst32[1] = packedcolors[src[1]];
+      dst32[2] = packedcolors[src[2]];
+      dst32[3] = packedcolors[src[3]];
+      dst32 += 4;
+      src += 4;
+      count -= 4;
+    }
+    while (count--) {
+      *dst32++ = packedcolors[*src++];
+    }
+  }
+};
+
+// colors of a display driver used to convert the bitmap drawn by the VIC
+// (packed or not) to RGB565, nothing is converted if the VIC draws native
+// pixels
+class BitmapPalette {
+private:
+  const uint16_t *colors;
+#ifdef USE_VIC_PACKEDBITMAP
+  uint32_t packedcolors[256];
+#endif
+
+public:
+  void init(const uint16_t *colors) {
+    this->colors = colors;
+#ifdef USE_VIC_PACKEDBITMAP
+    BitmapUtils::initPackedColors(colors, packedcolors);
+#endif
+  }
+
+  // converts count pixels starting at the beginning of a line, returns the
+  // RGB565 pixels (dst or, with native pixels, src)
+  inline const uint16_t *getBitmap(const uint8_t *src, uint16_t *dst,
+                                   uint16_t count) {
+#if defined(USE_VIC_PACKEDBITMAP)
+    BitmapUtils::getBitmapPacked(src, dst, packedcolors, count);
+#elif defined(USE_VIC_NATIVEPIXELS)
+    return (const uint16_t *)src;
+#else
+    BitmapUtils::getBitmap(src, dst, colors, count);
+#endif
+    return dst;
+  }
 };
 
 #endif
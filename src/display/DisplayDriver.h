@@ -52,7 +52,26 @@ protected:
       c64_orange, c64_brown,      c64_lightred,  c64_grey1,
       c64_grey2,  c64_lightgreen, c64_lightblue, c64_grey3};
 
+  // border color of row y of a display showing the bitmap at row
+  // borderheight (rows above / below the visible rasterlines get the color of
+  // the first / last visible rasterline)
+  static inline uint8_t getBorderColor(const uint8_t *bordercolors, uint16_t y,
+                                       uint16_t borderheight) {
+    int16_t i = y + BORDERTOPLINES - borderheight;
+    if (i < 0) {
+      i = 0;
+    } else if (i >= BORDERLINES) {
+      i = BORDERLINES - 1;
+    }
+    return bordercolors[i];
+  }
+
 public:
+  // rasterlines visible on a PAL display (16 - 299), the first line of the
+  // bitmap (rasterline 51) is preceded by BORDERTOPLINES lines of the border
+  static const uint16_t BORDERLINES = 284;
+  static const uint16_t BORDERTOPLINES = 35;
+
   /**
    * @brief Initializes the display hardware.
    *
@@ -71,7 +90,8 @@ public:
   /**
    * @brief Draws the provided bitmap.
    *
-   * The bitmap contains pixel data in 8-bit C64 color data format.
+   * The bitmap contains pixel data in 8-bit C64 color data format (see
+   * BitmapUtils for the packed and the native pixel layout).
    *
    * @param bitmap Pointer to the bitmap data.
    * @param vicreg Pointer to the VIC registers (usually ignored, used be
@@ -79,6 +99,66 @@ public:
    */
   virtual void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) = 0;
 
+  /**
+   * @brief Returns true if the display is able to update a span of lines
+   * (see drawBitmapLines()).
+   *
+   * If true, the VIC only sends the lines which have changed since the last
+   * refresh instead of calling drawBitmap(). In line streaming mode (see
+   * USE_VIC_LINESTREAMING) the VIC sends the lines as soon as they are drawn
+   * and does not need a frame buffer.
+   */
+  virtual bool supportsBitmapLines() { return false; }
+
+  /**
+   * @brief Draws consecutive lines of the bitmap.
+   *
+   * The driver sets a window covering the given lines and sends only their
+   * pixel data.
+   *
+   * @param lines Pointer to the pixel data of the first line to draw
+   * (BitmapUtils::LINEBYTES per line).
+   * @param vicreg Pointer to the VIC registers.
+   * @param firstline First line to draw (0 - 199).
+   * @param numoflines Number of lines to draw.
+   */
+  virtual void drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                               uint8_t firstline, uint8_t numoflines) {}
+
+  /**
+   * @brief Returns true if the display is able to draw a border color per
+   * rasterline (see drawBorderLines()).
+   *
+   * If true and USE_VIC_FULLBORDER is defined, the VIC records the border
+   * color of each visible rasterline and calls drawBorderLines() instead of
+   * drawFrame().
+   */
+  virtual bool supportsBorderLines() { return false; }
+
+  /**
+   * @brief Draws the border with a color per rasterline.
+   *
+   * Called by the VIC before drawBitmap() / drawBitmapLines(), so the driver
+   * may draw the border together with the bitmap.
+   *
+   * @param bordercolors 4-bit C64 color value of each visible rasterline
+   * (BORDERLINES values, see getBorderColor()).
+   */
+  virtual void drawBorderLines(const uint8_t *bordercolors) {}
+
+  /**
+   * @brief Returns a C64 color in the pixel format of the display.
+   *
+   * Used by the VIC to draw native pixels (see USE_VIC_NATIVEPIXELS) which are
+   * sent to the display without conversion. The default is RGB565 as stored in
+   * c64Colors.
+   *
+   * @param color 4-bit C64 color value.
+   */
+  virtual uint32_t getNativeColor(uint8_t color) {
+    return c64Colors[color & 15];
+  }
+
   /**
    * @brief Sets a hardware-specific operational mode for the display.
    *
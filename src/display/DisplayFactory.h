@@ -39,6 +39,18 @@
 #error "no valid display driver defined"
 #endif
 
+#if defined(USE_VIC_PACKEDBITMAP) && defined(USE_LEDMATRIXDISPLAY)
+#error "packed bitmap not supported by the LED matrix display"
+#endif
+
+#if defined(USE_VIC_NATIVEPIXELS) && defined(USE_LEDMATRIXDISPLAY)
+#error "native pixels not supported by the LED matrix display"
+#endif
+
+#if defined(USE_VIC_NATIVEPIXELS) && defined(USE_NOTCURSES_DISPLAY)
+#error "native pixels not supported by the notcurses display"
+#endif
+
 namespace Display {
 DisplayDriver *create() {
 #if defined(USE_ST7789V)
@@ -39,6 +39,7 @@ void ILI9341::init() {
   LCD_Set_Orientation(LCD_DISPLAY_ORIENTATION_LANDSCAPE);
   buffer = new uint16_t[BUFFERSIZE];
   oldFrameColor = 0;
+  palette.init(c64Colors);
 }
 
 void ILI9341::drawFrame(uint8_t frameColor) {
@@ -70,13 +71,27 @@ void ILI9341::drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) {
   uint16_t yend = 199 + BORDERHEIGHT;
   LCD_SetWindows(xstart, ystart, xend, yend + BORDERHEIGHT);
   for (uint8_t i = 0; i < 12; i++) {
-    BitmapUtils::getBitmap(bitmap + (i * DBBUFSIZE), buffer, c64Colors,
-                           DBBUFSIZE);
-    LCD_WriteDate(buffer, DBBUFSIZE * 2);
+    const uint16_t *data = palette.getBitmap(
+        bitmap + BitmapUtils::byteIndex(i * DBBUFSIZE), buffer, DBBUFSIZE);
+    LCD_WriteDate(data, DBBUFSIZE * 2);
+  }
+  const uint16_t *data = palette.getBitmap(
+      bitmap + BitmapUtils::byteIndex(12 * DBBUFSIZE), buffer, DBBUFSIZE / 2);
+  LCD_WriteDate(data, DBBUFSIZE);
+}
+
+void ILI9341::drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                              uint8_t firstline, uint8_t numoflines) {
+  uint16_t ystart = BORDERHEIGHT + firstline;
+  LCD_SetWindows(BORDERWIDTH, ystart, 319 + BORDERWIDTH,
+                 ystart + numoflines - 1);
+  while (numoflines > 0) {
+    uint8_t n = (numoflines > BUFNUMLINES) ? BUFNUMLINES : numoflines;
+    const uint16_t *data = palette.getBitmap(lines, buffer, n * 320);
+    LCD_WriteDate(data, n * 320 * 2);
+    lines += BitmapUtils::byteIndex(n * 320);
+    numoflines -= n;
   }
-  BitmapUtils::getBitmap(bitmap + (12 * DBBUFSIZE), buffer, c64Colors,
-                         DBBUFSIZE / 2);
-  LCD_WriteDate(buffer, DBBUFSIZE);
 }
 
 void ILI9341::reconfigureSPICYD() { LCD_Restore_Interface(); }
@@ -20,12 +20,25 @@
 #include "../Config.h"
 #ifdef USE_NODISPLAY
 #include "DisplayDriver.h"
+#include <atomic>
 
+// display sink without output, counts the bytes which would be sent to a
+// RGB565 display (used to measure partial display updates)
 class NoDisplay : public DisplayDriver {
 public:
+  std::atomic<uint64_t> numofbytessent{0};
+
   void init() override {}
   void drawFrame(uint8_t frameColor) override {}
-  void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override {}
+  void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override {
+    numofbytessent.fetch_add(320 * 200 * 2, std::memory_order_relaxed);
+  }
+  bool supportsBitmapLines() override { return true; }
+  void drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                       uint8_t firstline, uint8_t numoflines) override {
+    numofbytessent.fetch_add(numoflines * 320 * 2, std::memory_order_relaxed);
+  }
+  bool supportsBorderLines() override { return true; }
 };
 #endif
 
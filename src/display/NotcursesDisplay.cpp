@@ -69,7 +69,7 @@ void NotcursesDisplay::drawBitmap(const uint8_t *bitmap,
 
   for (unsigned int y = 0; y < term_rows && y < C64_HEIGHT; ++y) {
     for (unsigned int x = 0; x < term_cols && x < C64_WIDTH; ++x) {
-      uint8_t color_idx = bitmap[y * C64_WIDTH + x];
+      uint8_t color_idx = BitmapUtils::getPixel(bitmap, y * C64_WIDTH + x);
       uint16_t color_rgb565 = c64Colors[color_idx];
       uint32_t rgb = c64_to_notcurses_rgb(color_rgb565);
 
@@ -37,6 +37,7 @@ void RM67162::init() {
   lcd_setRotation(1);
   buffer = new uint16_t[BUFFERSIZE];
   oldFrameColor = 0;
+  palette.init(c64Colors);
 }
 
 void RM67162::drawFrame(uint8_t frameColor) {
@@ -64,11 +65,25 @@ void RM67162::drawFrame(uint8_t frameColor) {
 void RM67162::drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) {
   uint16_t ystart = BORDERHEIGHT;
   for (uint8_t i = 0; i < 200 / BUFNUMLINES; i++) {
-    BitmapUtils::getBitmap(bitmap + (i * DBBUFSIZE), buffer, c64Colors,
-                           DBBUFSIZE);
-    lcd_PushColors(BORDERWIDTH, ystart, 320, BUFNUMLINES, buffer);
+    const uint16_t *data = palette.getBitmap(
+        bitmap + BitmapUtils::byteIndex(i * DBBUFSIZE), buffer, DBBUFSIZE);
+    lcd_PushColors(BORDERWIDTH, ystart, 320, BUFNUMLINES,
+                   const_cast<uint16_t *>(data));
     ystart += BUFNUMLINES;
   }
 }
 
+void RM67162::drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                              uint8_t firstline, uint8_t numoflines) {
+  uint16_t ystart = BORDERHEIGHT + firstline;
+  while (numoflines > 0) {
+    uint8_t n = (numoflines > BUFNUMLINES) ? BUFNUMLINES : numoflines;
+    const uint16_t *data = palette.getBitmap(lines, buffer, n * 320);
+    lcd_PushColors(BORDERWIDTH, ystart, 320, n, const_cast<uint16_t *>(data));
+    lines += BitmapUtils::byteIndex(n * 320);
+    ystart += n;
+    numoflines -= n;
+  }
+}
+
 #endif
@@ -19,6 +19,7 @@
 
 #include "../Config.h"
 #ifdef USE_RM67162
+#include "BitmapUtils.h"
 #include "DisplayDriver.h"
 #include <cstdint>
 
@@ -51,11 +52,18 @@ private:
       c64_grey2,  c64_lightgreen, c64_lightblue, c64_grey3};
 
   uint8_t oldFrameColor;
+  BitmapPalette palette;
 
 public:
   void init() override;
   void drawFrame(uint8_t frameColor) override;
   void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override;
+  bool supportsBitmapLines() override { return true; }
+  void drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                       uint8_t firstline, uint8_t numoflines) override;
+  uint32_t getNativeColor(uint8_t color) override {
+    return c64Colors[color & 15];
+  }
 };
 #endif
 
@@ -5,6 +5,8 @@
 #include "SDLDisplay.h"
 #include "icon_data.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstring>
 
 void drawChar(SDL_Renderer *ren, uint16_t c, uint16_t x, uint16_t y,
               uint8_t charpixsize) {
@@ -25,6 +27,7 @@ void drawChar(SDL_Renderer *ren, uint16_t c, uint16_t x, uint16_t y,
 SDLDisplay::SDLDisplay() {}
 
 SDLDisplay::~SDLDisplay() {
+  delete[] screen;
   if (texture) {
     SDL_DestroyTexture(texture);
   }
@@ -69,39 +72,85 @@ void SDLDisplay::init() {
     throw std::runtime_error("SDL_CreateRenderer failed");
   }
   SDL_RenderSetLogicalSize(renderer, Config::LCDWIDTH, Config::LCDHEIGHT);
+#ifdef USE_VIC_NATIVEPIXELS
+  // the VIC draws XRGB8888 pixels which are copied as they are
+  texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB888,
+                              SDL_TEXTUREACCESS_STREAMING, Config::LCDWIDTH,
+                              Config::LCDHEIGHT);
+#else
   texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB565,
-                              SDL_TEXTUREACCESS_STREAMING, 320, 200);
+                              SDL_TEXTUREACCESS_STREAMING, Config::LCDWIDTH,
+                              Config::LCDHEIGHT);
+#endif
   if (!texture) {
     throw std::runtime_error("SDL_CreateTexture failed");
   }
-  bitmap16 = new uint16_t[320 * 200];
+  screen = new ScreenPixel[Config::LCDWIDTH * Config::LCDHEIGHT]();
+  for (uint8_t i = 0; i < 16; i++) {
+#ifdef USE_VIC_NATIVEPIXELS
+    screencolors[i] = getNativeColor(i);
+#else
+    screencolors[i] = c64Colors[i];
+#endif
+  }
+  memset(rowcolors, 0xff, sizeof(rowcolors));
+#ifndef USE_VIC_NATIVEPIXELS
+  palette.init(c64Colors);
+#endif
 }
 
-static inline void setDrawColor565(SDL_Renderer *r, uint16_t c) {
-  uint8_t R = ((c >> 11) & 0x1F) * 255 / 31;
-  uint8_t G = ((c >> 5) & 0x3F) * 255 / 63;
-  uint8_t B = (c & 0x1F) * 255 / 31;
-  SDL_SetRenderDrawColor(r, R, G, B, 255);
+uint32_t SDLDisplay::getNativeColor(uint8_t color) {
+  uint16_t c = c64Colors[color & 15];
+  uint32_t R = ((c >> 11) & 0x1F) * 255 / 31;
+  uint32_t G = ((c >> 5) & 0x3F) * 255 / 63;
+  uint32_t B = (c & 0x1F) * 255 / 31;
+  return (R << 16) | (G << 8) | B;
+}
+
+void SDLDisplay::fillBorderRow(uint16_t y, uint8_t color) {
+  rowcolors[y] = color;
+  ScreenPixel pixel = screencolors[color & 15];
+  ScreenPixel *row = screen + y * Config::LCDWIDTH;
+  if ((y < BORDERHEIGHT) || (y >= BORDERHEIGHT + 200)) {
+    std::fill(row, row + Config::LCDWIDTH, pixel);
+  } else {
+    std::fill(row, row + BORDERWIDTH, pixel);
+    std::fill(row + BORDERWIDTH + 320, row + Config::LCDWIDTH, pixel);
+  }
 }
 
 void SDLDisplay::drawFrame(uint8_t frameColor) {
-  uint16_t frameColor16 = c64Colors[frameColor];
-  setDrawColor565(renderer, frameColor16);
-  SDL_Rect top{0, 0, Config::LCDWIDTH, BORDERHEIGHT};
-  SDL_RenderFillRect(renderer, &top);
-  SDL_Rect bottom{0, BORDERHEIGHT + 200, Config::LCDWIDTH, BORDERHEIGHT};
-  SDL_RenderFillRect(renderer, &bottom);
-  SDL_Rect left{0, BORDERHEIGHT, BORDERWIDTH, 200};
-  SDL_RenderFillRect(renderer, &left);
-  SDL_Rect right{BORDERWIDTH + 320, BORDERHEIGHT, BORDERWIDTH, 200};
-  SDL_RenderFillRect(renderer, &right);
+  for (uint16_t y = 0; y < Config::LCDHEIGHT; y++) {
+    if (rowcolors[y] != frameColor) {
+      fillBorderRow(y, frameColor);
+    }
+  }
+}
+
+void SDLDisplay::drawBorderLines(const uint8_t *bordercolors) {
+  for (uint16_t y = 0; y < Config::LCDHEIGHT; y++) {
+    uint8_t color = getBorderColor(bordercolors, y, BORDERHEIGHT);
+    if (rowcolors[y] != color) {
+      fillBorderRow(y, color);
+    }
+  }
 }
 
 void SDLDisplay::drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) {
-  BitmapUtils::getBitmap(bitmap, bitmap16, c64Colors, 320 * 200);
-  SDL_UpdateTexture(texture, nullptr, bitmap16, 320 * sizeof(uint16_t));
-  SDL_Rect dst{BORDERWIDTH, BORDERHEIGHT, 320, 200};
-  SDL_RenderCopy(renderer, texture, nullptr, &dst);
+  // copy the bitmap into the buffer, send the whole window to the texture
+  ScreenPixel *dst = screen + BORDERHEIGHT * Config::LCDWIDTH + BORDERWIDTH;
+  for (uint8_t y = 0; y < 200; y++) {
+#ifdef USE_VIC_NATIVEPIXELS
+    memcpy(dst, bitmap, BitmapUtils::LINEBYTES);
+#else
+    palette.getBitmap(bitmap, dst, 320);
+#endif
+    bitmap += BitmapUtils::LINEBYTES;
+    dst += Config::LCDWIDTH;
+  }
+  SDL_UpdateTexture(texture, nullptr, screen,
+                    Config::LCDWIDTH * sizeof(ScreenPixel));
+  SDL_RenderCopy(renderer, texture, nullptr, nullptr);
   SDL_RenderPresent(renderer);
 }
 #endif
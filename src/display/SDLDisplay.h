@@ -3,6 +3,7 @@
 
 #include "../Config.h"
 #ifdef USE_SDL_DISPLAY
+#include "BitmapUtils.h"
 #include "DisplayDriver.h"
 #include <SDL2/SDL.h>
 #include <cstdint>
@@ -15,7 +16,20 @@ private:
   SDL_Window *window = nullptr;
   SDL_Renderer *renderer = nullptr;
   SDL_Texture *texture = nullptr;
-  uint16_t *bitmap16;
+  // the window (border and bitmap) is drawn into a buffer which is copied to
+  // the texture in one pass, the border color of each row of the buffer is
+  // kept to fill only the rows whose color has changed
+#ifdef USE_VIC_NATIVEPIXELS
+  typedef uint32_t ScreenPixel;
+#else
+  typedef uint16_t ScreenPixel;
+  BitmapPalette palette;
+#endif
+  ScreenPixel *screen = nullptr;
+  ScreenPixel screencolors[16];
+  uint8_t rowcolors[Config::LCDHEIGHT];
+
+  void fillBorderRow(uint16_t y, uint8_t color);
 
 public:
   SDLDisplay();
@@ -23,6 +37,9 @@ public:
   void init() override;
   void drawFrame(uint8_t frameColor) override;
   void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override;
+  bool supportsBorderLines() override { return true; }
+  void drawBorderLines(const uint8_t *bordercolors) override;
+  uint32_t getNativeColor(uint8_t color) override;
 };
 #endif
 
@@ -19,6 +19,7 @@
 #include "ST7789V.h"
 #include <driver/gpio.h>
 #include <freertos/FreeRTOS.h>
+#include <cstring>
 #include <soc/gpio_struct.h>
 #include <stdexcept>
 
@@ -130,6 +131,7 @@ void ST7789V::init() {
   GPIO.out1_w1ts.val = (1ULL << (Config::BL - 32)); // backlight
 
   oldFrameColor = 0;
+  memset(sentbordercolors, 0xff, sizeof(sentbordercolors));
 }
 
 void ST7789V::copyinit(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h) {
@@ -183,10 +185,25 @@ void ST7789V::copyData(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h,
                        const uint8_t *data) {
   copyinit(x0, y0, w, h);
   uint32_t clearMask = lu_pinbitmask[255];
+#ifdef USE_VIC_PACKEDBITMAP
+  // two pixels per byte
+  for (uint32_t i = 0; i < w * h; i += 2) {
+    uint8_t data8 = *data++;
+    copycopy(c64Colors[data8 & 0x0f], clearMask);
+    copycopy(c64Colors[data8 >> 4], clearMask);
+  }
+#elif defined(USE_VIC_NATIVEPIXELS)
+  // RGB565 pixels
+  const uint16_t *data16 = (const uint16_t *)data;
+  for (uint32_t i = 0; i < w * h; i++) {
+    copycopy(*data16++, clearMask);
+  }
+#else
   for (uint32_t i = 0; i < w * h; i++) {
     uint16_t data16 = c64Colors[*data++ & 0x0f];
     copycopy(data16, clearMask);
   }
+#endif
   copyend();
 }
 
@@ -207,7 +224,43 @@ void ST7789V::drawFrame(uint8_t frameColor) {
   }
 }
 
+void ST7789V::drawBorderLines(const uint8_t *bordercolors) {
+  // send runs of rows with the same border color which differ from the rows
+  // shown on the display (rows beside the bitmap only consist of the left and
+  // right border)
+  uint16_t y = 0;
+  while (y < Config::LCDHEIGHT) {
+    uint8_t color = getBorderColor(bordercolors, y, BORDERHEIGHT);
+    if (color == sentbordercolors[y]) {
+      y++;
+      continue;
+    }
+    bool besidebitmap = (y >= BORDERHEIGHT) && (y < BORDERHEIGHT + 200);
+    uint16_t firstrow = y;
+    do {
+      sentbordercolors[y] = color;
+      y++;
+    } while ((y < Config::LCDHEIGHT) && (sentbordercolors[y] != color) &&
+             (getBorderColor(bordercolors, y, BORDERHEIGHT) == color) &&
+             (((y >= BORDERHEIGHT) && (y < BORDERHEIGHT + 200)) ==
+              besidebitmap));
+    uint16_t h = y - firstrow;
+    if (!besidebitmap) {
+      ST7789V::copyColor(0, firstrow, Config::LCDWIDTH, h, color);
+    } else if (BORDERWIDTH > 0) {
+      ST7789V::copyColor(0, firstrow, BORDERWIDTH, h, color);
+      ST7789V::copyColor(BORDERWIDTH + 320, firstrow, BORDERWIDTH, h, color);
+    }
+  }
+}
+
 void ST7789V::drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) {
   ST7789V::copyData(BORDERWIDTH, BORDERHEIGHT, 320, 200, bitmap);
 }
+
+void ST7789V::drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                              uint8_t firstline, uint8_t numoflines) {
+  ST7789V::copyData(BORDERWIDTH, BORDERHEIGHT + firstline, 320, numoflines,
+                    lines);
+}
 #endif
@@ -33,6 +33,8 @@ private:
       MAX(320 * BORDERHEIGHT, BORDERWIDTH *Config::LCDHEIGHT);
 
   uint16_t oldFrameColor;
+  // border color of each row shown on the display (see drawBorderLines())
+  uint8_t sentbordercolors[Config::LCDHEIGHT];
 
   inline static void writeCmd(uint8_t cmd) __attribute__((always_inline));
   inline static void writeData(uint8_t data) __attribute__((always_inline));
@@ -50,6 +52,11 @@ public:
   void init() override;
   void drawFrame(uint8_t frameColor) override;
   void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override;
+  bool supportsBitmapLines() override { return true; }
+  void drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                       uint8_t firstline, uint8_t numoflines) override;
+  bool supportsBorderLines() override { return true; }
+  void drawBorderLines(const uint8_t *bordercolors) override;
 };
 #endif
 
@@ -30,6 +30,7 @@ void ST7789VSerial::init() {
   LCD_Init();
   Backlight_Init();
   oldFrameColor = 0;
+  palette.init(c64Colors);
 }
 
 void ST7789VSerial::drawFrame(uint8_t frameColor) {
@@ -68,12 +69,27 @@ void ST7789VSerial::drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) {
   uint16_t yend = BORDERHEIGHT + BUFNUMLINES - 1;
   const uint16_t BUFSIZE = 320 * BUFNUMLINES;
   for (uint8_t i = 0; i < 200 / BUFNUMLINES; i++) {
-    BitmapUtils::getBitmap(bitmap + (i * BUFSIZE), transferBuffer, c64Colors,
-                           BUFSIZE);
-    LCD_addWindow(xstart, ystart, xend, yend, transferBuffer);
+    const uint16_t *data = palette.getBitmap(
+        bitmap + BitmapUtils::byteIndex(i * BUFSIZE), transferBuffer, BUFSIZE);
+    LCD_addWindow(xstart, ystart, xend, yend, const_cast<uint16_t *>(data));
     ystart += BUFNUMLINES;
     yend += BUFNUMLINES;
   }
 }
 
+void ST7789VSerial::drawBitmapLines(const uint8_t *lines,
+                                    const uint8_t *vicreg, uint8_t firstline,
+                                    uint8_t numoflines) {
+  uint16_t ystart = BORDERHEIGHT + firstline;
+  while (numoflines > 0) {
+    uint8_t n = (numoflines > BUFNUMLINES) ? BUFNUMLINES : numoflines;
+    const uint16_t *data = palette.getBitmap(lines, transferBuffer, n * 320);
+    LCD_addWindow(BORDERWIDTH, ystart, 319 + BORDERWIDTH, ystart + n - 1,
+                  const_cast<uint16_t *>(data));
+    lines += BitmapUtils::byteIndex(n * 320);
+    ystart += n;
+    numoflines -= n;
+  }
+}
+
 #endif
@@ -19,6 +19,7 @@
 
 #include "../Config.h"
 #ifdef USE_ST7789VSERIAL
+#include "BitmapUtils.h"
 #include "DisplayDriver.h"
 #include <cstdint>
 
@@ -33,11 +34,15 @@ private:
       MAX(BORDERHEIGHT * Config::LCDWIDTH, BORDERWIDTH * 200);
   static uint16_t *framecolormem;
   uint8_t oldFrameColor;
+  BitmapPalette palette;
 
 public:
   void init() override;
   void drawFrame(uint8_t frameColor) override;
   void drawBitmap(const uint8_t *bitmap, const uint8_t *vicreg) override;
+  bool supportsBitmapLines() override { return true; }
+  void drawBitmapLines(const uint8_t *lines, const uint8_t *vicreg,
+                       uint8_t firstline, uint8_t numoflines) override;
 };
 #endif
 
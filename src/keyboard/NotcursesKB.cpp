@@ -104,6 +104,7 @@ void NotcursesKB::handleKeyEvent(uint32_t ch, bool shift, bool ctrl, bool alt,
                                     "        IN PORT 1, IN PORT 2, NO\r"
                                     "        JOYSTICK\r"
                                     "CTRL-P TO PAUSE\r"
+                                    "CTRL-W TO SWITCH WARP MODE ON/OFF\r"
                                     "COMMODORE KEY = LEFT ALT\r\x9a\0";
       extcmd.cmd = ExtCmd::WRITETEXT;
       int16_t helpsize = sizeof(help);
@@ -159,6 +160,10 @@ void NotcursesKB::handleKeyEvent(uint32_t ch, bool shift, bool ctrl, bool alt,
     case 'P':
       extcmd.cmd = ExtCmd::PAUSE;
       break;
+    case 'w':
+    case 'W':
+      extcmd.cmd = ExtCmd::WARP;
+      break;
     case 'j':
     case 'J':
       switch (joystickmode) {
@@ -137,6 +137,7 @@ void SDLKB::handleKeyEvent(SDL_Keysym keysym, SDL_Keymod mod, bool pressed) {
                                "        IN PORT 1, IN PORT 2, NO\r"
                                "        JOYSTICK\r"
                                "RCTRL-P TO PAUSE\r"
+                               "RCTRL-W TO SWITCH WARP MODE ON/OFF\r"
                                "COMMODORE KEY = LEFT ALT\r\x9a\0";
         extcmd.cmd = ExtCmd::WRITETEXT;
         int16_t helpsize = sizeof(help);
@@ -188,6 +189,9 @@ void SDLKB::handleKeyEvent(SDL_Keysym keysym, SDL_Keymod mod, bool pressed) {
       } else if (key == SDLK_p) {
         extcmd.cmd = ExtCmd::PAUSE;
         ExtCmdQueue::getInstance().push(extcmd);
+      } else if (key == SDLK_w) {
+        extcmd.cmd = ExtCmd::WARP;
+        ExtCmdQueue::getInstance().push(extcmd);
       } else if (key == SDLK_k) {
         switch (kbjoystickmode) {
         case ExtCmd::KBJOYSTICKMODEOFF:
@@ -112,6 +112,21 @@ public:
   virtual void startTask(std::function<void(void *)> fn, uint8_t core,
                          uint8_t prio) = 0;
 
+  /**
+   * @brief Signals the completion of a frame to the task waiting in
+   * waitForFrame().
+   */
+  virtual void notifyFrame() = 0;
+
+  /**
+   * @brief Waits until a frame is signaled by notifyFrame() (used by a single
+   * task, the display loop).
+   *
+   * @param timeoutms Maximal time to wait in milliseconds.
+   * @return true if a frame was signaled, false on timeout.
+   */
+  virtual bool waitForFrame(uint32_t timeoutms) = 0;
+
   /**
    * @brief Acquires an exclusive lock on the hardware bus (SPI). Used for the
    * CYD.
@@ -27,6 +27,7 @@
 #include <esp_random.h>
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -51,6 +52,9 @@ private:
     std::function<void(void *)> func;
   };
 
+  // task waiting in waitForFrame() (the display loop)
+  std::atomic<TaskHandle_t> frameTask{nullptr};
+
   static void taskEntryPoint(void *arg) {
     std::unique_ptr<TaskContext> ctx(static_cast<TaskContext *>(arg));
     if (ctx && ctx->func) {
@@ -133,6 +137,18 @@ public:
     xTaskCreatePinnedToCore(taskEntryPoint, "genericTask", 10000, ctx, prio,
                             nullptr, core);
   }
+
+  void notifyFrame() override {
+    TaskHandle_t task = frameTask.load(std::memory_order_acquire);
+    if (task != nullptr) {
+      xTaskNotifyGive(task);
+    }
+  }
+
+  bool waitForFrame(uint32_t timeoutms) override {
+    frameTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutms)) > 0;
+  }
 };
 #endif
 
@@ -20,6 +20,8 @@
 #include "../Config.h"
 #ifdef PLATFORM_LINUX
 #include "Platform.h"
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -31,6 +33,11 @@
 #include <unistd.h>
 
 class PlatformLinux : public Platform {
+private:
+  std::mutex frameMutex;
+  std::condition_variable frameCond;
+  bool frameSignaled = false;
+
 public:
   PlatformLinux() = default;
 
@@ -99,6 +106,23 @@ public:
     std::thread([fn]() { fn(nullptr); }).detach();
   }
 
+  void notifyFrame() override {
+    {
+      std::lock_guard<std::mutex> lock(frameMutex);
+      frameSignaled = true;
+    }
+    frameCond.notify_one();
+  }
+
+  bool waitForFrame(uint32_t timeoutms) override {
+    std::unique_lock<std::mutex> lock(frameMutex);
+    bool signaled =
+        frameCond.wait_for(lock, std::chrono::milliseconds(timeoutms),
+                           [this] { return frameSignaled; });
+    frameSignaled = false;
+    return signaled;
+  }
+
   ~PlatformLinux() override = default;
 };
 #endif
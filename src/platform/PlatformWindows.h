@@ -21,9 +21,11 @@
 #ifdef _WIN32
 #include "Platform.h"
 #include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
 #include <functional>
+#include <mutex>
 #include <random>
 #include <thread>
 #define SID Windows_SID_Internal
@@ -31,6 +33,11 @@
 #undef SID
 
 class PlatformWindows : public Platform {
+private:
+  std::mutex frameMutex;
+  std::condition_variable frameCond;
+  bool frameSignaled = false;
+
 public:
   PlatformWindows() { timeBeginPeriod(1); }
 
@@ -90,6 +97,23 @@ public:
     std::thread([fn]() { fn(nullptr); }).detach();
   }
 
+  void notifyFrame() override {
+    {
+      std::lock_guard<std::mutex> lock(frameMutex);
+      frameSignaled = true;
+    }
+    frameCond.notify_one();
+  }
+
+  bool waitForFrame(uint32_t timeoutms) override {
+    std::unique_lock<std::mutex> lock(frameMutex);
+    bool signaled =
+        frameCond.wait_for(lock, std::chrono::milliseconds(timeoutms),
+                           [this] { return frameSignaled; });
+    frameSignaled = false;
+    return signaled;
+  }
+
   ~PlatformWindows() { timeEndPeriod(1); }
 };
 #endif
@@ -28,6 +28,10 @@
 class SDLSound : public SoundDriver {
 public:
 private:
+  // maximal number of buffered samples (200 ms), older samples are dropped
+  // (e.g. in warp mode)
+  static const size_t MAXNUMOFSAMPLES = AUDIO_SAMPLE_RATE / 5;
+
   SDL_AudioDeviceID audioDevice = 0;
   std::deque<int16_t> audioBuffer;
   std::mutex bufferMutex;
@@ -84,6 +88,10 @@ public:
     std::lock_guard<std::mutex> lock(bufferMutex);
     audioBuffer.insert(audioBuffer.end(), samples,
                        samples + (size / sizeof(int16_t)));
+    if (audioBuffer.size() > MAXNUMOFSAMPLES) {
+      audioBuffer.erase(audioBuffer.begin(),
+                        audioBuffer.end() - MAXNUMOFSAMPLES);
+    }
   }
 
   ~SDLSound() override {